@@ -0,0 +1,159 @@
+#include "Combinatorics.h"
+#include "LimbVector.h"
+#include "ProductTree.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+    // Длина отрезка решета в нечётных числах: битовый массив отрезка занимает 32 КБ
+    constexpr std::uint32_t SIEVE_SEGMENT = 32768 * 8;
+
+    std::uint32_t isqrt32(std::uint32_t n) {
+        std::uint64_t r = 0;
+        while ((r + 1) * (r + 1) <= n)
+            ++r;
+        return static_cast<std::uint32_t>(r);
+    }
+
+    // Показатель двойки в n!: n минус число единиц в двоичной записи n (формула Лежандра для p = 2)
+    std::size_t twoExponent(std::uint32_t n) {
+        std::size_t ones = 0;
+        for (std::uint32_t m = n; m != 0; m &= m - 1)
+            ++ones;
+        return n - ones;
+    }
+}
+
+std::vector<std::uint32_t> Combinatorics::primes(std::uint32_t limit) {
+    std::vector<std::uint32_t> result;
+    if (limit < 2)
+        return result;
+    result.push_back(2);
+
+    // Простые до sqrt(limit) - обычным решетом, ими просеиваются отрезки
+    const std::uint32_t root = isqrt32(limit);
+    std::vector<bool> small(root + 1, true);
+    std::vector<std::uint32_t> base;
+    for (std::uint32_t i = 3; i <= root; i += 2) {
+        if (!small[i])
+            continue;
+        base.push_back(i);
+        for (std::uint64_t j = std::uint64_t{i} * i; j <= root; j += 2 * i)
+            small[j] = false;
+    }
+
+    // Отрезок [low, low + 2 * SIEVE_SEGMENT) хранит только нечётные числа: бит j - число low + 2j
+    std::vector<bool> composite(SIEVE_SEGMENT);
+    for (std::uint64_t low = 3; low <= limit; low += 2 * std::uint64_t{SIEVE_SEGMENT}) {
+        const std::uint64_t high = std::min<std::uint64_t>(low + 2 * std::uint64_t{SIEVE_SEGMENT} - 2, limit);
+        const std::size_t count = static_cast<std::size_t>((high - low) / 2 + 1);
+        std::fill(composite.begin(), composite.begin() + count, false);
+        for (std::uint32_t p : base) {
+            const std::uint64_t square = std::uint64_t{p} * p;
+            if (square > high)
+                break;
+            // Первое нечётное кратное p в отрезке, не меньшее p^2
+            std::uint64_t start = std::max(square, (low + p - 1) / p * p);
+            if (start % 2 == 0)
+                start += p;
+            for (std::uint64_t j = start; j <= high; j += 2 * std::uint64_t{p})
+                composite[(j - low) / 2] = true;
+        }
+        for (std::size_t j = 0; j < count; ++j) {
+            if (!composite[j])
+                result.push_back(static_cast<std::uint32_t>(low + 2 * j));
+        }
+    }
+    return result;
+}
+
+void Combinatorics::appendPower(std::vector<std::vector<Limb>> &factors, Limb &packed, Limb p, std::size_t e) {
+    for (std::size_t i = 0; i < e; ++i) {
+        if (packed > std::numeric_limits<Limb>::max() / p) {
+            factors.push_back({packed});
+            packed = 1;
+        }
+        packed *= p;
+    }
+}
+
+std::vector<Limb> Combinatorics::shiftLeftBits(const std::vector<Limb> &x, std::size_t bits) {
+    if (x.empty())
+        return {};
+    const std::size_t limbShift = bits / LimbArithmetic::LIMB_BITS;
+    const unsigned bitShift = static_cast<unsigned>(bits % LimbArithmetic::LIMB_BITS);
+    std::vector<Limb> result(limbShift + x.size() + 1, 0);
+    if (bitShift == 0)
+        std::copy(x.begin(), x.end(), result.begin() + limbShift);
+    else
+        result[limbShift + x.size()] = LimbArithmetic::shiftLeft(result.data() + limbShift, x.data(), x.size(), bitShift);
+    LimbVector::trim(result);
+    return result;
+}
+
+// Показатель нечётного простого p в swing(n) - число нечётных среди n / p, n / p^2, ...
+std::vector<Limb> Combinatorics::oddSwing(std::uint32_t n, const std::vector<std::uint32_t> &primes) {
+    std::vector<std::vector<Limb>> factors;
+    Limb packed = 1;
+    for (std::size_t i = 1; i < primes.size() && primes[i] <= n; ++i) {
+        const std::uint32_t p = primes[i];
+        std::size_t e = 0;
+        for (std::uint64_t q = n / p; q > 0; q /= p)
+            e += q & 1;
+        appendPower(factors, packed, p, e);
+    }
+    if (packed != 1)
+        factors.push_back({packed});
+    return ProductTree::product(factors);
+}
+
+std::vector<Limb> Combinatorics::oddFactorial(std::uint32_t n, const std::vector<std::uint32_t> &primes) {
+    if (n < 3)
+        return {1};
+    std::vector<Limb> half = oddFactorial(n / 2, primes);
+    return LimbVector::multiply(LimbVector::multiply(half, half), oddSwing(n, primes));
+}
+
+std::vector<Limb> Combinatorics::factorial(std::uint32_t n) {
+    return shiftLeftBits(oddFactorial(n, primes(n)), twoExponent(n));
+}
+
+// Показатель p в C(n, k) - число заёмов при вычитании k из n в системе с основанием p (теорема Куммера)
+std::vector<Limb> Combinatorics::binomial(std::uint32_t n, std::uint32_t k) {
+    if (k > n)
+        return {};
+    k = std::min(k, n - k);
+    if (k == 0)
+        return {1};
+
+    std::vector<std::vector<Limb>> factors;
+    Limb packed = 1;
+    for (std::uint32_t p : primes(n)) {
+        std::size_t e = 0;
+        if (std::uint64_t{p} * p > n) {
+            e = n % p < k % p ? 1 : 0; // для p > sqrt(n) заём возможен только в младшем разряде
+        } else {
+            std::uint64_t a = n, b = k, borrow = 0;
+            while (a > 0) {
+                borrow = a % p < b % p + borrow ? 1 : 0;
+                e += borrow;
+                a /= p;
+                b /= p;
+            }
+        }
+        appendPower(factors, packed, p, e);
+    }
+    if (packed != 1)
+        factors.push_back({packed});
+    return ProductTree::product(factors);
+}
+
+std::vector<Limb> Combinatorics::primorial(std::uint32_t n) {
+    std::vector<std::vector<Limb>> factors;
+    Limb packed = 1;
+    for (std::uint32_t p : primes(n))
+        appendPower(factors, packed, p, 1);
+    if (packed != 1)
+        factors.push_back({packed});
+    return ProductTree::product(factors);
+}
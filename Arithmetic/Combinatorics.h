@@ -0,0 +1,45 @@
+#ifndef DMATGCOLLOQUIUM_COMBINATORICS_H
+#define DMATGCOLLOQUIUM_COMBINATORICS_H
+
+#include "LimbArithmetic.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Факториал, биномиальный коэффициент и примориал через разложение на простые.
+ *
+ * Произведение 1 * 2 * ... * n подряд умножает растущее число на одно слово и стоит O(n^2).
+ * Здесь результат собирается из степеней простых: показатель каждого простого p <= n известен
+ * заранее (формула Лежандра), степени упаковываются по слову и перемножаются деревом
+ * произведений (см. ProductTree). Факториал считается через "качание" (prime swing) Люшного:
+ * n! = ((n/2)!)^2 * swing(n), где swing(n) = n! / ((n/2)!)^2 содержит каждое простое p в степени
+ * не выше log_p(n), а нечётные и чётные множители разделены - степень двойки добавляется одним
+ * сдвигом в конце. Простые до n берутся сегментированным решетом Эратосфена.
+ */
+class Combinatorics {
+public:
+    static std::vector<Limb> factorial(std::uint32_t n);
+
+    /**
+     * @brief C(n, k), при k > n - ноль.
+     */
+    static std::vector<Limb> binomial(std::uint32_t n, std::uint32_t k);
+
+    /**
+     * @brief Произведение всех простых, не превосходящих n (для n < 2 - 1).
+     */
+    static std::vector<Limb> primorial(std::uint32_t n);
+
+private:
+    // Простые до limit по возрастанию: решето до sqrt(limit), затем отрезки, помещающиеся в кэш
+    static std::vector<std::uint32_t> primes(std::uint32_t limit);
+    // Нечётная часть n!, primes - простые не меньше чем до n
+    static std::vector<Limb> oddFactorial(std::uint32_t n, const std::vector<std::uint32_t>& primes);
+    static std::vector<Limb> oddSwing(std::uint32_t n, const std::vector<std::uint32_t>& primes);
+    // Добавляет p^e к множителям, упаковывая простые в слова, пока произведение помещается в 64 бита
+    static void appendPower(std::vector<std::vector<Limb>>& factors, Limb& packed, Limb p, std::size_t e);
+    static std::vector<Limb> shiftLeftBits(const std::vector<Limb>& x, std::size_t bits);
+};
+
+
+#endif //DMATGCOLLOQUIUM_COMBINATORICS_H
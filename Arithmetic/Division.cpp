@@ -0,0 +1,215 @@
+#include "Division.h"
+#include "LimbVector.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+    DivisionThresholds currentThresholds;
+}
+
+DivisionThresholds Division::getThresholds() {
+    return currentThresholds;
+}
+
+void Division::setThresholds(const DivisionThresholds &thresholds) {
+    // Обратное число строится рекурсией по половинам, на двух словах она уже должна остановиться
+    currentThresholds.newton = std::max<std::size_t>(thresholds.newton, 2);
+}
+
+void Division::divideRemainder(Limb *q, Limb *r, const Limb *a, std::size_t an, const Limb *d, std::size_t dn) {
+    // Обращение делителя окупается, только если и делитель, и частное длинные
+    if (dn >= currentThresholds.newton && an - dn + 1 >= currentThresholds.newton)
+        divideNewton(q, r, a, an, d, dn);
+    else
+        divideSchoolbook(q, r, a, an, d, dn);
+}
+
+void Division::divideSchoolbook(Limb *q, Limb *r, const Limb *a, std::size_t an, const Limb *d, std::size_t dn) {
+    if (dn == 1) {
+        std::vector<Limb> discarded(q ? 0 : an);
+        Limb rem = LimbArithmetic::divRem1(q ? q : discarded.data(), a, an, d[0]);
+        if (r)
+            r[0] = rem;
+        return;
+    }
+
+    // Один рабочий буфер: нормализованный остаток (an + 1 слово) и нормализованный делитель (dn слов)
+    const unsigned shift = LimbArithmetic::countLeadingZeros(d[dn - 1]);
+    std::vector<Limb> scratch(an + 1 + dn);
+    Limb *u = scratch.data();
+    Limb *v = u + an + 1;
+    if (shift) {
+        LimbArithmetic::shiftLeft(v, d, dn, shift);
+        u[an] = LimbArithmetic::shiftLeft(u, a, an, shift);
+    } else {
+        std::copy(d, d + dn, v);
+        std::copy(a, a + an, u);
+        u[an] = 0;
+    }
+
+    const Limb vTop = v[dn - 1];
+    const Limb vNext = v[dn - 2];
+    for (std::size_t j = an - dn + 1; j-- > 0;) {
+        // Оценка цифры частного по двум старшим словам текущего остатка
+        Limb qHat;
+        Limb rHat;
+        bool rHatOverflow = false;
+        if (u[j + dn] >= vTop) {
+            // u[j+dn] == vTop: оценка 2^64 - 1, остаток rHat = u[j+dn-1] + vTop может не поместиться в слово
+            qHat = ~static_cast<Limb>(0);
+            DoubleLimb sum = static_cast<DoubleLimb>(u[j + dn - 1]) + vTop;
+            rHat = static_cast<Limb>(sum);
+            rHatOverflow = (sum >> LimbArithmetic::LIMB_BITS) != 0;
+        } else {
+            DoubleLimb top = (static_cast<DoubleLimb>(u[j + dn]) << LimbArithmetic::LIMB_BITS) | u[j + dn - 1];
+            qHat = static_cast<Limb>(top / vTop);
+            rHat = static_cast<Limb>(top % vTop);
+        }
+        // Уточнение по второму слову делителя: не больше двух уменьшений
+        while (!rHatOverflow &&
+               static_cast<DoubleLimb>(qHat) * vNext >
+               ((static_cast<DoubleLimb>(rHat) << LimbArithmetic::LIMB_BITS) | u[j + dn - 2])) {
+            --qHat;
+            DoubleLimb sum = static_cast<DoubleLimb>(rHat) + vTop;
+            rHat = static_cast<Limb>(sum);
+            rHatOverflow = (sum >> LimbArithmetic::LIMB_BITS) != 0;
+        }
+
+        // u[j..j+dn] -= qHat * v; если ушли в минус, оценка была на единицу больше
+        Limb borrow = LimbArithmetic::subMul1(u + j, v, dn, qHat);
+        Limb top = u[j + dn];
+        u[j + dn] = top - borrow;
+        if (top < borrow) {
+            --qHat;
+            u[j + dn] += LimbArithmetic::addN(u + j, u + j, v, dn);
+        }
+        if (q)
+            q[j] = qHat;
+    }
+
+    if (r) {
+        if (shift)
+            LimbArithmetic::shiftRight(r, u, dn, shift);
+        else
+            std::copy(u, u + dn, r);
+    }
+}
+
+// Обратное к старшей половине v уточняется одним шагом Ньютона X = X0 + X0 * (B^(2n) - v * X0) / B^(2n),
+// а остаточная ошибка в несколько единиц снимается проверкой через B^(2n) - v * X.
+std::vector<Limb> Division::reciprocal(const std::vector<Limb> &v) {
+    const std::size_t n = v.size();
+    std::vector<Limb> power(2 * n + 1, 0); // B^(2n)
+    power[2 * n] = 1;
+
+    std::vector<Limb> x;
+    if (n <= currentThresholds.newton / 2) {
+        x.resize(n + 2);
+        divideSchoolbook(x.data(), nullptr, power.data(), power.size(), v.data(), n);
+        LimbVector::trim(x);
+        return x;
+    }
+
+    const std::size_t h = (n + 1) / 2;
+    const std::vector<Limb> high(v.end() - static_cast<std::ptrdiff_t>(h), v.end());
+    const std::vector<Limb> xHigh = reciprocal(high);
+
+    // X0 = xHigh * B^(n - h)
+    x.assign(n - h, 0);
+    x.insert(x.end(), xHigh.begin(), xHigh.end());
+
+    std::vector<Limb> product = LimbVector::multiply(v, x);
+    std::vector<Limb> error;
+    const bool overshoot = LimbVector::compare(product, power) > 0;
+    if (overshoot) {
+        error = product;
+        LimbVector::subtractInPlace(error, power);
+    } else {
+        error = power;
+        LimbVector::subtractInPlace(error, product);
+    }
+    std::vector<Limb> correction = LimbVector::multiply(x, error);
+    correction.erase(correction.begin(), correction.begin() + static_cast<std::ptrdiff_t>(std::min(correction.size(), 2 * n)));
+    if (overshoot) {
+        LimbVector::increment(correction);
+        if (LimbVector::compare(correction, x) >= 0)
+            x.clear();
+        else
+            LimbVector::subtractInPlace(x, correction);
+    } else {
+        LimbVector::addInPlace(x, correction);
+    }
+
+    // Точная доводка: 0 <= B^(2n) - v * X < v
+    product = LimbVector::multiply(v, x);
+    while (LimbVector::compare(product, power) > 0) {
+        LimbVector::decrement(x);
+        LimbVector::subtractInPlace(product, v);
+    }
+    std::vector<Limb> rest = power;
+    LimbVector::subtractInPlace(rest, product);
+    while (LimbVector::compare(rest, v) >= 0) {
+        LimbVector::increment(x);
+        LimbVector::subtractInPlace(rest, v);
+    }
+    return x;
+}
+
+void Division::divideNewton(Limb *q, Limb *r, const Limb *a, std::size_t an, const Limb *d, std::size_t dn) {
+    const std::size_t n = dn;
+    const unsigned shift = LimbArithmetic::countLeadingZeros(d[dn - 1]);
+    std::vector<Limb> v(n);
+    std::vector<Limb> u(an + 1);
+    if (shift) {
+        LimbArithmetic::shiftLeft(v.data(), d, n, shift);
+        u[an] = LimbArithmetic::shiftLeft(u.data(), a, an, shift);
+    } else {
+        std::copy(d, d + n, v.begin());
+        std::copy(a, a + an, u.begin());
+    }
+    LimbVector::trim(u);
+
+    const std::vector<Limb> x = reciprocal(v);
+
+    // Деление в столбик по основанию B^n: остаток всегда меньше v
+    const std::size_t blocks = (u.size() + n - 1) / n;
+    std::vector<Limb> quotient(std::max(blocks * n, an - dn + 1), 0);
+    std::vector<Limb> rest;
+    std::vector<Limb> current;
+    for (std::size_t block = blocks; block-- > 0;) {
+        const std::size_t low = block * n;
+        const std::size_t high = std::min(u.size(), low + n);
+        current.assign(u.begin() + static_cast<std::ptrdiff_t>(low), u.begin() + static_cast<std::ptrdiff_t>(high));
+        if (!rest.empty()) {
+            current.resize(n, 0);
+            current.insert(current.end(), rest.begin(), rest.end());
+        }
+        LimbVector::trim(current);
+        if (LimbVector::compare(current, v) < 0) {
+            rest = current;
+            continue;
+        }
+
+        // Оценка снизу: floor(current / B^(n-1)) * X / B^(n+1) <= current / v, ошибка не больше пары единиц
+        std::vector<Limb> digit = LimbVector::multiply(current.data() + (n - 1), current.size() - (n - 1), x.data(), x.size());
+        digit.erase(digit.begin(), digit.begin() + static_cast<std::ptrdiff_t>(std::min(digit.size(), n + 1)));
+        const std::vector<Limb> product = LimbVector::multiply(digit, v);
+        LimbVector::subtractInPlace(current, product);
+        while (LimbVector::compare(current, v) >= 0) {
+            LimbVector::increment(digit);
+            LimbVector::subtractInPlace(current, v);
+        }
+        std::copy(digit.begin(), digit.end(), quotient.begin() + static_cast<std::ptrdiff_t>(low));
+        rest = current;
+    }
+
+    if (q)
+        std::copy(quotient.begin(), quotient.begin() + static_cast<std::ptrdiff_t>(an - dn + 1), q);
+    if (r) {
+        rest.resize(n, 0);
+        if (shift)
+            LimbArithmetic::shiftRight(r, rest.data(), n, shift);
+        else
+            std::copy(rest.begin(), rest.end(), r);
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef DMATGCOLLOQUIUM_DIVISION_H
+#define DMATGCOLLOQUIUM_DIVISION_H
+
+#include "LimbArithmetic.h"
+#include <vector>
+
+/**
+ * @brief Пороги переключения алгоритмов деления, в словах.
+ */
+struct DivisionThresholds {
+    std::size_t newton = 3500; /**< длина делителя и частного, начиная с которой деление идёт через обратное число */
+};
+
+/**
+ * @brief Деление массивов слов с остатком.
+ *
+ * Для коротких делителей или коротких частных используется деление в столбик (алгоритм D Кнута),
+ * для длинных - умножение на обратное число, вычисленное итерациями Ньютона, что сводит деление
+ * к нескольким быстрым умножениям.
+ */
+class Division {
+public:
+    /**
+     * @brief Деление с остатком, алгоритм выбирается по длине делителя и частного.
+     *
+     * @param q Буфер частного длины an - dn + 1 (может быть nullptr, если частное не нужно).
+     * @param r Буфер остатка длины dn (может быть nullptr, если остаток не нужен).
+     * @param a Делимое длины an, an >= dn.
+     * @param d Делитель длины dn > 0 без старших нулевых слов.
+     */
+    static void divideRemainder(Limb* q, Limb* r, const Limb* a, std::size_t an, const Limb* d, std::size_t dn);
+
+    static DivisionThresholds getThresholds();
+    static void setThresholds(const DivisionThresholds& thresholds);
+
+private:
+    /**
+     * @brief Деление в столбик по алгоритму D Кнута.
+     *
+     * Делитель нормализуется сдвигом так, чтобы старший бит его старшего слова был единичным.
+     * Тогда цифра частного, оценённая по двум старшим словам остатка и двум старшим словам делителя,
+     * превышает верную не больше чем на единицу, и редкая ошибка исправляется обратным сложением.
+     * Вся работа идёт на месте в одном рабочем буфере, без проб и исключений.
+     */
+    static void divideSchoolbook(Limb* q, Limb* r, const Limb* a, std::size_t an, const Limb* d, std::size_t dn);
+
+    /**
+     * @brief Деление умножением на обратное число.
+     *
+     * Нормализованный делитель v длины n обращается итерациями Ньютона: X = floor(B^(2n) / v).
+     * Делимое обрабатывается блоками по n слов от старших к младшим, как деление в столбик
+     * в системе с основанием B^n: цифра частного оценивается одним умножением на X снизу
+     * и доводится не более чем несколькими вычитаниями.
+     */
+    static void divideNewton(Limb* q, Limb* r, const Limb* a, std::size_t an, const Limb* d, std::size_t dn);
+
+    /**
+     * @brief X = floor(B^(2n) / v) для нормализованного v длины n, итерациями Ньютона с удвоением точности.
+     */
+    static std::vector<Limb> reciprocal(const std::vector<Limb>& v);
+};
+
+
+#endif //DMATGCOLLOQUIUM_DIVISION_H
@@ -0,0 +1,117 @@
+#include "Exponentiation.h"
+#include "LimbVector.h"
+#include "Montgomery.h"
+
+namespace {
+    bool bitAt(const Limb *e, std::size_t i) {
+        return (e[i / LimbArithmetic::LIMB_BITS] >> (i % LimbArithmetic::LIMB_BITS)) & 1;
+    }
+
+    // square(x): x = x^2, multiply(x, y): x = x * y - в той арифметике, в которой идёт возведение
+    template<class Square, class Multiply>
+    std::vector<Limb> slidingWindow(const std::vector<Limb> &base, const Limb *e, std::size_t en, unsigned k,
+                                    std::vector<Limb> one, Square square, Multiply multiply) {
+        if (en == 0)
+            return one;
+        const std::size_t bits = en * LimbArithmetic::LIMB_BITS - LimbArithmetic::countLeadingZeros(e[en - 1]);
+
+        // table[j] = base^(2j + 1)
+        std::vector<std::vector<Limb>> table(std::size_t{1} << (k - 1));
+        table[0] = base;
+        if (table.size() > 1) {
+            std::vector<Limb> baseSquared = base;
+            square(baseSquared);
+            for (std::size_t j = 1; j < table.size(); ++j) {
+                table[j] = table[j - 1];
+                multiply(table[j], baseSquared);
+            }
+        }
+
+        std::vector<Limb> result;
+        bool started = false;
+        std::size_t i = bits;
+        while (i > 0) {
+            if (!bitAt(e, i - 1)) {
+                if (started)
+                    square(result);
+                --i;
+                continue;
+            }
+            // Окно - биты [low, i), старший и младший из них единичные
+            std::size_t low = i > k ? i - k : 0;
+            while (!bitAt(e, low))
+                ++low;
+            std::size_t value = 0;
+            for (std::size_t j = i; j-- > low;)
+                value = (value << 1) | static_cast<std::size_t>(bitAt(e, j));
+
+            if (started) {
+                for (std::size_t j = low; j < i; ++j)
+                    square(result);
+                multiply(result, table[value >> 1]);
+            } else {
+                result = table[value >> 1];
+                started = true;
+            }
+            i = low;
+        }
+        return result;
+    }
+}
+
+unsigned Exponentiation::windowSize(std::size_t bits) {
+    // Окно k стоит 2^(k-1) предвычисленных умножений и экономит умножения на каждом окне показателя
+    if (bits <= 7)
+        return 1;
+    if (bits <= 36)
+        return 2;
+    if (bits <= 140)
+        return 3;
+    if (bits <= 450)
+        return 4;
+    if (bits <= 1303)
+        return 5;
+    return 6;
+}
+
+std::vector<Limb> Exponentiation::power(const std::vector<Limb> &base, const Limb *e, std::size_t en) {
+    const std::size_t bits = en == 0 ? 0 : en * LimbArithmetic::LIMB_BITS - LimbArithmetic::countLeadingZeros(e[en - 1]);
+    return slidingWindow(base, e, en, windowSize(bits), {1},
+                         [](std::vector<Limb> &x) { x = LimbVector::multiply(x, x); },
+                         [](std::vector<Limb> &x, const std::vector<Limb> &y) { x = LimbVector::multiply(x, y); });
+}
+
+std::vector<Limb> Exponentiation::modPower(const std::vector<Limb> &base, const Limb *e, std::size_t en,
+                                           const std::vector<Limb> &modulus) {
+    if (modulus.size() == 1 && modulus[0] == 1)
+        return {};
+    const std::size_t bits = en == 0 ? 0 : en * LimbArithmetic::LIMB_BITS - LimbArithmetic::countLeadingZeros(e[en - 1]);
+    const unsigned k = windowSize(bits);
+
+    if (modulus[0] & 1) {
+        const MontgomeryContext context(modulus);
+        std::vector<Limb> result = slidingWindow(
+                context.toMontgomery(base), e, en, k, context.one(),
+                [&context](std::vector<Limb> &x) { context.square(x, x); },
+                [&context](std::vector<Limb> &x, const std::vector<Limb> &y) { context.multiply(x, x, y); });
+        return context.fromMontgomery(result);
+    }
+
+    // Форма Монтгомери требует нечётного модуля, для чётного остаток берётся делением
+    auto reduce = [&modulus](std::vector<Limb> &x) {
+        std::vector<Limb> rest;
+        LimbVector::divideRemainder(x, modulus, nullptr, &rest);
+        x = std::move(rest);
+    };
+    std::vector<Limb> reducedBase = base;
+    reduce(reducedBase);
+    return slidingWindow(reducedBase, e, en, k, {1},
+                         [&reduce](std::vector<Limb> &x) {
+                             x = LimbVector::multiply(x, x);
+                             reduce(x);
+                         },
+                         [&reduce](std::vector<Limb> &x, const std::vector<Limb> &y) {
+                             x = LimbVector::multiply(x, y);
+                             reduce(x);
+                         });
+}
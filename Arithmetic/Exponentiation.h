@@ -0,0 +1,36 @@
+#ifndef DMATGCOLLOQUIUM_EXPONENTIATION_H
+#define DMATGCOLLOQUIUM_EXPONENTIATION_H
+
+#include "LimbArithmetic.h"
+#include <vector>
+
+/**
+ * @brief Возведение в степень скользящим окном.
+ *
+ * Показатель просматривается от старших бит к младшим. Нулевые биты дают только возведение
+ * в квадрат, а группа бит длиной до k, начинающаяся и заканчивающаяся единицей, - k квадратов
+ * и одно умножение на заранее посчитанную нечётную степень основания. Ширина окна k растёт
+ * с длиной показателя, так что умножений выходит около bits / (k + 1) вместо bits / 2.
+ *
+ * Для нечётного модуля умножения идут в форме Монтгомери (см. MontgomeryContext) без делений,
+ * для чётного - обычное умножение с остатком от деления.
+ */
+class Exponentiation {
+public:
+    /**
+     * @brief base^e, показатель - нормализованный массив e[0..en), 0^0 = 1.
+     */
+    static std::vector<Limb> power(const std::vector<Limb>& base, const Limb* e, std::size_t en);
+
+    /**
+     * @brief base^e mod m при m > 0, все числа нормализованы, 0^0 = 1.
+     */
+    static std::vector<Limb> modPower(const std::vector<Limb>& base, const Limb* e, std::size_t en,
+                                      const std::vector<Limb>& modulus);
+
+private:
+    static unsigned windowSize(std::size_t bits);
+};
+
+
+#endif //DMATGCOLLOQUIUM_EXPONENTIATION_H
@@ -0,0 +1,260 @@
+#include "GreatestCommonDivisor.h"
+#include "LimbVector.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+    GcdThresholds currentThresholds;
+
+    // Старшие 62 бита числа v при сдвиге, нормализующем старшее слово длины n
+    int64_t leadingBits(const std::vector<Limb> &v, std::size_t n, unsigned shift) {
+        auto limb = [&v](std::size_t i) { return i < v.size() ? v[i] : 0; };
+        Limb high = limb(n - 1) << shift;
+        if (shift && n >= 2)
+            high |= limb(n - 2) >> (LimbArithmetic::LIMB_BITS - shift);
+        return static_cast<int64_t>(high >> 2);
+    }
+
+    // |pc * pos - nc * neg| при условии, что разность неотрицательна
+    std::vector<Limb> combine(const std::vector<Limb> &pos, Limb pc, const std::vector<Limb> &neg, Limb nc) {
+        std::vector<Limb> result(std::max(pos.size(), neg.size()) + 1, 0);
+        result[pos.size()] = LimbArithmetic::mul1(result.data(), pos.data(), pos.size(), pc);
+        Limb borrow = LimbArithmetic::subMul1(result.data(), neg.data(), neg.size(), nc);
+        if (borrow)
+            LimbArithmetic::sub1(result.data() + neg.size(), result.data() + neg.size(),
+                                 result.size() - neg.size(), borrow);
+        LimbVector::trim(result);
+        return result;
+    }
+
+    std::vector<Limb> sum(const std::vector<Limb> &x, const std::vector<Limb> &y) {
+        std::vector<Limb> result = x;
+        LimbVector::addInPlace(result, y);
+        return result;
+    }
+}
+
+GcdThresholds GreatestCommonDivisor::getThresholds() {
+    return currentThresholds;
+}
+
+void GreatestCommonDivisor::setThresholds(const GcdThresholds &thresholds) {
+    // Рекурсия half-GCD берёт старшие половины, на коротких числах она должна уступать Лемеру
+    currentThresholds.halfGcd = std::max<std::size_t>(thresholds.halfGcd, 8);
+}
+
+std::vector<Limb> GreatestCommonDivisor::gcd(std::vector<Limb> a, std::vector<Limb> b) {
+    if (LimbVector::compare(a, b) < 0)
+        std::swap(a, b);
+
+    while (!b.empty()) {
+        if (a.size() <= 2) {
+            auto wide = [](const std::vector<Limb> &v) {
+                DoubleLimb value = v.empty() ? 0 : v[0];
+                if (v.size() == 2)
+                    value |= static_cast<DoubleLimb>(v[1]) << LimbArithmetic::LIMB_BITS;
+                return value;
+            };
+            DoubleLimb g = binaryGcd(wide(a), wide(b));
+            std::vector<Limb> result{static_cast<Limb>(g), static_cast<Limb>(g >> LimbArithmetic::LIMB_BITS)};
+            LimbVector::trim(result);
+            return result;
+        }
+        if (b.size() == 1) {
+            std::vector<Limb> discarded(a.size());
+            Limb rest = LimbArithmetic::divRem1(discarded.data(), a.data(), a.size(), b[0]);
+            return {binaryGcd(b[0], rest)};
+        }
+        if (a.size() >= currentThresholds.halfGcd && halfGcd(a, b, nullptr))
+            continue;
+        lehmerStep(a, b, nullptr);
+    }
+    return a;
+}
+
+Limb GreatestCommonDivisor::binaryGcd(Limb a, Limb b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    const unsigned common = LimbArithmetic::countTrailingZeros(a | b);
+    a >>= LimbArithmetic::countTrailingZeros(a);
+    while (b != 0) {
+        b >>= LimbArithmetic::countTrailingZeros(b);
+        if (a > b)
+            std::swap(a, b);
+        b -= a;
+    }
+    return a << common;
+}
+
+DoubleLimb GreatestCommonDivisor::binaryGcd(DoubleLimb a, DoubleLimb b) {
+    auto trailingZeros = [](DoubleLimb x) {
+        auto low = static_cast<Limb>(x);
+        return low ? LimbArithmetic::countTrailingZeros(low)
+                   : LimbArithmetic::LIMB_BITS + LimbArithmetic::countTrailingZeros(static_cast<Limb>(x >> LimbArithmetic::LIMB_BITS));
+    };
+    if (a == 0) return b;
+    if (b == 0) return a;
+    const unsigned common = trailingZeros(a | b);
+    a >>= trailingZeros(a);
+    while (b != 0) {
+        // Когда оба числа влезли в слово, дальше быстрее на машинных словах
+        if ((a >> LimbArithmetic::LIMB_BITS) == 0 && (b >> LimbArithmetic::LIMB_BITS) == 0)
+            return static_cast<DoubleLimb>(binaryGcd(static_cast<Limb>(a), static_cast<Limb>(b))) << common;
+        b >>= trailingZeros(b);
+        if (a > b)
+            std::swap(a, b);
+        b -= a;
+    }
+    return a << common;
+}
+
+// Алгоритм L Кнута: пока частные, вычисленные по двум оценкам старших битов снизу и сверху,
+// совпадают, они совпадают и с настоящими частными Евклида для полных чисел.
+void GreatestCommonDivisor::lehmerStep(std::vector<Limb> &a, std::vector<Limb> &b, Matrix *m) {
+    const std::size_t n = a.size();
+    const unsigned shift = LimbArithmetic::countLeadingZeros(a[n - 1]);
+    int64_t x = leadingBits(a, n, shift);
+    int64_t y = leadingBits(b, n, shift);
+
+    int64_t A = 1, B = 0, C = 0, D = 1;
+    bool odd = false;
+    while (y + C > 0 && y + D > 0) {
+        const int64_t q = (x + A) / (y + C);
+        if (q != (x + B) / (y + D))
+            break;
+        int64_t t = A - q * C;
+        A = C;
+        C = t;
+        t = B - q * D;
+        B = D;
+        D = t;
+        t = x - q * y;
+        x = y;
+        y = t;
+        odd = !odd;
+    }
+
+    if (B == 0) {
+        // Старших битов не хватило даже на одно частное: полный шаг деления
+        euclidStep(a, b, m);
+        return;
+    }
+
+    // Знаки чередуются: на чётном шаге A, D >= 0 и B, C <= 0, на нечётном наоборот
+    auto magnitude = [](int64_t v) { return static_cast<Limb>(v < 0 ? -v : v); };
+    std::vector<Limb> nextA = odd ? combine(b, magnitude(B), a, magnitude(A)) : combine(a, magnitude(A), b, magnitude(B));
+    std::vector<Limb> nextB = odd ? combine(a, magnitude(C), b, magnitude(D)) : combine(b, magnitude(D), a, magnitude(C));
+    a = std::move(nextA);
+    b = std::move(nextB);
+
+    if (m) {
+        Matrix step;
+        step.m00 = {magnitude(D)};
+        step.m01 = {magnitude(B)};
+        step.m10 = {magnitude(C)};
+        step.m11 = {magnitude(A)};
+        for (std::vector<Limb> *entry : {&step.m00, &step.m01, &step.m10, &step.m11})
+            LimbVector::trim(*entry);
+        step.negativeDeterminant = odd;
+        multiplyInto(*m, step);
+    }
+}
+
+void GreatestCommonDivisor::euclidStep(std::vector<Limb> &a, std::vector<Limb> &b, Matrix *m) {
+    std::vector<Limb> q;
+    std::vector<Limb> r;
+    LimbVector::divideRemainder(a, b, m ? &q : nullptr, &r);
+    a = std::move(b);
+    b = std::move(r);
+    if (m) {
+        Matrix step;
+        step.m00 = std::move(q);
+        step.m01 = {1};
+        step.m10 = {1};
+        step.m11.clear();
+        step.negativeDeterminant = true;
+        multiplyInto(*m, step);
+    }
+}
+
+// Числа длины m уменьшаются до m/2 + O(1) слов. Сначала рекурсия по старшей половине уменьшает их
+// примерно до 3m/4 слов, затем рекурсия по старшим 2(n - m/2) словам доводит до цели.
+bool GreatestCommonDivisor::halfGcd(std::vector<Limb> &a, std::vector<Limb> &b, Matrix *m) {
+    const std::size_t size = a.size();
+    const std::size_t target = size / 2 + 2;
+    if (b.size() <= target)
+        return false;
+    if (size < currentThresholds.halfGcd) {
+        while (b.size() > target)
+            lehmerStep(a, b, m);
+        return true;
+    }
+
+    // Рекурсия по k старшим словам уменьшает числа до n - k/2 + O(1) слов
+    const std::size_t wanted = 2 * (target - 2);
+    bool first = true;
+    while (b.size() > target) {
+        const std::size_t n = a.size();
+        const std::size_t low = first ? size / 2 : std::max(wanted > n ? wanted - n : 0, size / 4);
+        first = false;
+        std::vector<Limb> aHigh = LimbVector::shiftRightLimbs(a, low);
+        std::vector<Limb> bHigh = LimbVector::shiftRightLimbs(b, low);
+        Matrix part;
+        if (halfGcd(aHigh, bHigh, &part) && adjust(part, low, aHigh, bHigh, a, b)) {
+            if (m)
+                multiplyInto(*m, part);
+        } else {
+            lehmerStep(a, b, m);
+        }
+    }
+    return true;
+}
+
+// Старшие части уже преобразованы рекурсией, поэтому на матрицу умножаются только младшие low слов:
+// a' = aHigh * B^low + (M^(-1) (aLow, bLow))_0, b' аналогично.
+bool GreatestCommonDivisor::adjust(const Matrix &m, std::size_t low,
+                                   const std::vector<Limb> &aHigh, const std::vector<Limb> &bHigh,
+                                   std::vector<Limb> &a, std::vector<Limb> &b) {
+    const std::size_t aLow = LimbArithmetic::normalizedSize(a.data(), std::min(low, a.size()));
+    const std::size_t bLow = LimbArithmetic::normalizedSize(b.data(), std::min(low, b.size()));
+    std::vector<Limb> plusA = LimbVector::multiply(m.m11.data(), m.m11.size(), a.data(), aLow);
+    std::vector<Limb> minusA = LimbVector::multiply(m.m01.data(), m.m01.size(), b.data(), bLow);
+    std::vector<Limb> plusB = LimbVector::multiply(m.m00.data(), m.m00.size(), b.data(), bLow);
+    std::vector<Limb> minusB = LimbVector::multiply(m.m10.data(), m.m10.size(), a.data(), aLow);
+    if (m.negativeDeterminant) {
+        std::swap(plusA, minusA);
+        std::swap(plusB, minusB);
+    }
+
+    auto combineHigh = [low](const std::vector<Limb> &high, std::vector<Limb> &plus, const std::vector<Limb> &minus) {
+        if (!high.empty()) {
+            std::vector<Limb> shifted(low, 0);
+            shifted.insert(shifted.end(), high.begin(), high.end());
+            LimbVector::addInPlace(plus, shifted);
+        }
+        if (LimbVector::compare(plus, minus) < 0)
+            return false;
+        LimbVector::subtractInPlace(plus, minus);
+        return true;
+    };
+    // Матрица, построенная по старшим словам, может не подойти для полных чисел:
+    // тогда результат отрицателен или нарушает a >= b, и числа не меняются
+    if (!combineHigh(aHigh, plusA, minusA) || !combineHigh(bHigh, plusB, minusB) ||
+        LimbVector::compare(plusA, plusB) < 0)
+        return false;
+    a = std::move(plusA);
+    b = std::move(plusB);
+    return true;
+}
+
+void GreatestCommonDivisor::multiplyInto(Matrix &m, const Matrix &other) {
+    std::vector<Limb> m00 = sum(LimbVector::multiply(m.m00, other.m00), LimbVector::multiply(m.m01, other.m10));
+    std::vector<Limb> m01 = sum(LimbVector::multiply(m.m00, other.m01), LimbVector::multiply(m.m01, other.m11));
+    std::vector<Limb> m10 = sum(LimbVector::multiply(m.m10, other.m00), LimbVector::multiply(m.m11, other.m10));
+    std::vector<Limb> m11 = sum(LimbVector::multiply(m.m10, other.m01), LimbVector::multiply(m.m11, other.m11));
+    m.m00 = std::move(m00);
+    m.m01 = std::move(m01);
+    m.m10 = std::move(m10);
+    m.m11 = std::move(m11);
+    m.negativeDeterminant = m.negativeDeterminant != other.negativeDeterminant;
+}
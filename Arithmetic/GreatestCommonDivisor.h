@@ -0,0 +1,57 @@
+#ifndef DMATGCOLLOQUIUM_GREATESTCOMMONDIVISOR_H
+#define DMATGCOLLOQUIUM_GREATESTCOMMONDIVISOR_H
+
+#include "LimbArithmetic.h"
+#include <vector>
+
+/**
+ * @brief Пороги переключения алгоритмов НОД, в словах.
+ */
+struct GcdThresholds {
+    std::size_t halfGcd = 640; /**< начиная с этой длины шаги Лемера объединяются рекурсивным half-GCD */
+};
+
+/**
+ * @brief Движок НОД массивов слов.
+ *
+ * - числа длиной до двух слов: бинарный алгоритм (Штейна) на машинных словах;
+ * - длинные числа: алгоритм Лемера - частные Евклида угадываются по старшим 62 битам
+ *   в одинарной точности, а к полным числам применяется сразу накопленная матрица кофакторов;
+ * - очень длинные числа: half-GCD - матрица, уменьшающая числа вдвое, строится рекурсивно
+ *   по старшим половинам и применяется к полным числам быстрым умножением.
+ *
+ * Матрицы кофакторов унимодулярны, поэтому любое их применение сохраняет НОД. Если матрица,
+ * построенная по старшим словам, не подходит для полных чисел (получается отрицательное
+ * значение), она отбрасывается и делается обычный шаг Евклида.
+ */
+class GreatestCommonDivisor {
+public:
+    /**
+     * @brief НОД двух нормализованных чисел, хотя бы одно из которых ненулевое.
+     */
+    static std::vector<Limb> gcd(std::vector<Limb> a, std::vector<Limb> b);
+
+    static GcdThresholds getThresholds();
+    static void setThresholds(const GcdThresholds& thresholds);
+
+private:
+    /**
+     * @brief Матрица M с неотрицательными элементами: (a, b) исходные = M * (a, b) текущие.
+     */
+    struct Matrix {
+        std::vector<Limb> m00{1}, m01, m10, m11{1};
+        bool negativeDeterminant = false;
+    };
+
+    static Limb binaryGcd(Limb a, Limb b);
+    static DoubleLimb binaryGcd(DoubleLimb a, DoubleLimb b);
+    static void lehmerStep(std::vector<Limb>& a, std::vector<Limb>& b, Matrix* m);
+    static void euclidStep(std::vector<Limb>& a, std::vector<Limb>& b, Matrix* m);
+    static bool halfGcd(std::vector<Limb>& a, std::vector<Limb>& b, Matrix* m);
+    static bool adjust(const Matrix& m, std::size_t low, const std::vector<Limb>& aHigh, const std::vector<Limb>& bHigh,
+                       std::vector<Limb>& a, std::vector<Limb>& b);
+    static void multiplyInto(Matrix& m, const Matrix& other);
+};
+
+
+#endif //DMATGCOLLOQUIUM_GREATESTCOMMONDIVISOR_H
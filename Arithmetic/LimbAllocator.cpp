@@ -0,0 +1,150 @@
+#include "LimbAllocator.h"
+#include <array>
+#include <cstring>
+#include <new>
+
+namespace {
+    // Классы пула: буферы из 2^c слов при MIN_CLASS <= c <= MAX_CLASS
+    constexpr unsigned MIN_CLASS = 2;
+    constexpr unsigned MAX_CLASS = 12;
+    // В каждом классе кэшируется не больше 2^16 слов (512 КБ), остальное отдаётся системе
+    constexpr std::size_t CACHED_LIMBS_PER_CLASS = std::size_t{1} << 16;
+    constexpr std::size_t ARENA_CHUNK_LIMBS = std::size_t{1} << 13;
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    struct PoolCache {
+        std::array<FreeBlock *, MAX_CLASS + 1> heads{};
+        std::array<std::size_t, MAX_CLASS + 1> counts{};
+
+        ~PoolCache() {
+            for (FreeBlock *head : heads) {
+                while (head) {
+                    FreeBlock *next = head->next;
+                    delete[] reinterpret_cast<Limb *>(head);
+                    head = next;
+                }
+            }
+        }
+    };
+
+    static_assert(sizeof(std::atomic<std::size_t>) == sizeof(Limb), "reference counter must fit one limb");
+
+    thread_local PoolCache poolCache;
+    thread_local LimbAllocator *currentAllocator = nullptr;
+
+    unsigned sizeClass(std::size_t capacity) {
+        unsigned c = MIN_CLASS;
+        while ((std::size_t{1} << c) < capacity)
+            ++c;
+        return c;
+    }
+}
+
+Limb *LimbAllocator::allocate(std::size_t &capacity) {
+    LimbAllocator &owner = current();
+    Limb *block = owner.allocateBlock(capacity);
+    LimbAllocator *ownerPointer = &owner;
+    std::memcpy(block, &ownerPointer, sizeof(ownerPointer));
+    new(block + 1) std::atomic<std::size_t>(1);
+    return block + HEADER_LIMBS;
+}
+
+void LimbAllocator::deallocate(Limb *limbs, std::size_t capacity) noexcept {
+    owner(limbs)->deallocateBlock(limbs - HEADER_LIMBS, capacity);
+}
+
+LimbAllocator *LimbAllocator::owner(const Limb *limbs) noexcept {
+    LimbAllocator *result;
+    std::memcpy(&result, limbs - HEADER_LIMBS, sizeof(result));
+    return result;
+}
+
+std::atomic<std::size_t> &LimbAllocator::references(Limb *limbs) noexcept {
+    return *std::launder(reinterpret_cast<std::atomic<std::size_t> *>(limbs - 1));
+}
+
+LimbAllocator &LimbAllocator::current() noexcept {
+    return currentAllocator ? *currentAllocator : LimbPool::instance();
+}
+
+LimbAllocator *LimbAllocator::install(LimbAllocator *allocator) noexcept {
+    LimbAllocator *previous = currentAllocator;
+    currentAllocator = allocator;
+    return previous;
+}
+
+LimbPool &LimbPool::instance() noexcept {
+    static LimbPool pool;
+    return pool;
+}
+
+Limb *LimbPool::allocateBlock(std::size_t &capacity) {
+    if (capacity > (std::size_t{1} << MAX_CLASS))
+        return new Limb[capacity + HEADER_LIMBS];
+    const unsigned c = sizeClass(capacity);
+    capacity = std::size_t{1} << c;
+    FreeBlock *&head = poolCache.heads[c];
+    if (head) {
+        FreeBlock *block = head;
+        head = block->next;
+        --poolCache.counts[c];
+        return reinterpret_cast<Limb *>(block);
+    }
+    return new Limb[capacity + HEADER_LIMBS];
+}
+
+void LimbPool::deallocateBlock(Limb *block, std::size_t capacity) noexcept {
+    if (capacity > (std::size_t{1} << MAX_CLASS)) {
+        delete[] block;
+        return;
+    }
+    const unsigned c = sizeClass(capacity);
+    if ((poolCache.counts[c] + 1) << c > CACHED_LIMBS_PER_CLASS) {
+        delete[] block;
+        return;
+    }
+    auto *freeBlock = reinterpret_cast<FreeBlock *>(block);
+    freeBlock->next = poolCache.heads[c];
+    poolCache.heads[c] = freeBlock;
+    ++poolCache.counts[c];
+}
+
+LimbArena::LimbArena() : previous(LimbAllocator::install(this)), installed(true) {}
+
+LimbArena::~LimbArena() {
+    this->uninstall();
+    for (Limb *chunk : this->chunks)
+        delete[] chunk;
+}
+
+void LimbArena::uninstall() noexcept {
+    if (this->installed) {
+        LimbAllocator::install(this->previous);
+        this->installed = false;
+    }
+}
+
+Limb *LimbArena::allocateBlock(std::size_t &capacity) {
+    const std::size_t needed = capacity + HEADER_LIMBS;
+    if (needed > this->available) {
+        // Буфер длиннее куска получает собственный кусок, текущий кусок при этом не теряется
+        if (needed > ARENA_CHUNK_LIMBS / 2) {
+            this->chunks.push_back(new Limb[needed]);
+            return this->chunks.back();
+        }
+        this->chunks.push_back(new Limb[ARENA_CHUNK_LIMBS]);
+        this->cursor = this->chunks.back();
+        this->available = ARENA_CHUNK_LIMBS;
+    }
+    Limb *block = this->cursor;
+    this->cursor += needed;
+    this->available -= needed;
+    return block;
+}
+
+void LimbArena::deallocateBlock(Limb *, std::size_t) noexcept {
+    // Память арены освобождается целиком в деструкторе
+}
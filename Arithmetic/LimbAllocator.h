@@ -0,0 +1,142 @@
+#ifndef DMATGCOLLOQUIUM_LIMBALLOCATOR_H
+#define DMATGCOLLOQUIUM_LIMBALLOCATOR_H
+
+#include "LimbArithmetic.h"
+#include <atomic>
+#include <vector>
+
+/**
+ * @brief Источник буферов слов для длинных чисел (см. LimbStorage).
+ *
+ * У каждого потока есть текущий распределитель, по умолчанию - пул с классами размеров (LimbPool).
+ * Перед каждым буфером лежат два служебных слова: указатель на выделивший его распределитель
+ * (буфер возвращается туда, откуда взят, даже если текущий распределитель уже сменился)
+ * и счётчик ссылок, которым владельцы буфера делят его между собой (см. LimbStorage).
+ * Свой распределитель можно подключить, унаследовав этот класс и установив его через install.
+ */
+class LimbAllocator {
+public:
+    static constexpr std::size_t HEADER_LIMBS = 2;
+
+    virtual ~LimbAllocator() = default;
+
+    /**
+     * @brief Буфер не меньше чем из capacity слов от текущего распределителя потока.
+     * В capacity записывается фактический размер буфера.
+     */
+    static Limb* allocate(std::size_t& capacity);
+
+    /**
+     * @brief Возвращает буфер, полученный от allocate, с тем размером, который allocate записал в capacity.
+     */
+    static void deallocate(Limb* limbs, std::size_t capacity) noexcept;
+
+    /**
+     * @brief Распределитель, выделивший буфер.
+     */
+    static LimbAllocator* owner(const Limb* limbs) noexcept;
+
+    /**
+     * @brief Счётчик ссылок буфера, после allocate равен 1. Сам распределитель его не читает.
+     */
+    static std::atomic<std::size_t>& references(Limb* limbs) noexcept;
+
+    /**
+     * @brief Текущий распределитель потока.
+     */
+    static LimbAllocator& current() noexcept;
+
+    /**
+     * @brief Делает allocator текущим для потока (nullptr - пул по умолчанию), возвращает предыдущий.
+     */
+    static LimbAllocator* install(LimbAllocator* allocator) noexcept;
+
+protected:
+    /**
+     * @brief Блок из capacity + HEADER_LIMBS слов (первые - служебные), capacity можно увеличить.
+     */
+    virtual Limb* allocateBlock(std::size_t& capacity) = 0;
+    virtual void deallocateBlock(Limb* block, std::size_t capacity) noexcept = 0;
+};
+
+/**
+ * @brief Распределитель по умолчанию: размеры округляются вверх до степени двойки,
+ * освобождённые буферы до 4096 слов не отдаются системе, а кэшируются в списках своего класса.
+ *
+ * Списки свободных буферов у каждого потока свои, поэтому блокировок нет. Буфер, освобождённый
+ * в другом потоке, попадает в списки этого потока - все буферы пула взаимозаменяемы.
+ */
+class LimbPool : public LimbAllocator {
+public:
+    static LimbPool& instance() noexcept;
+
+protected:
+    Limb* allocateBlock(std::size_t& capacity) override;
+    void deallocateBlock(Limb* block, std::size_t capacity) noexcept override;
+};
+
+/**
+ * @brief Арена: буферы нарезаются подряд из больших кусков памяти, освобождение буфера ничего
+ * не делает, а вся память арены возвращается разом при её уничтожении.
+ *
+ * Конструктор делает арену текущим распределителем потока, деструктор возвращает предыдущий.
+ * Числа, созданные внутри области арены, не должны её переживать: результат вычисления нужно
+ * скопировать после uninstall (это делает run). По той же причине внутри арены нельзя наращивать
+ * числа, созданные вне её, - их новый буфер оказался бы в памяти арены. Константные методы, которые
+ * подменяют буферы числа (сокращение в RationalNumber), на это время возвращают пул через LimbPoolScope.
+ */
+class LimbArena : public LimbAllocator {
+public:
+    LimbArena();
+    ~LimbArena() override;
+    LimbArena(const LimbArena&) = delete;
+    LimbArena& operator=(const LimbArena&) = delete;
+
+    /**
+     * @brief Возвращает потоку распределитель, бывший текущим до арены. Память арены остаётся живой.
+     */
+    void uninstall() noexcept;
+
+    /**
+     * @brief Выполняет compute внутри арены и возвращает копию результата, сделанную уже вне её.
+     */
+    template<class Compute>
+    static auto run(Compute&& compute) -> decltype(compute()) {
+        using Result = decltype(compute());
+        LimbArena arena;
+        Result inside = compute();
+        arena.uninstall();
+        return Result(static_cast<const Result&>(inside));
+    }
+
+protected:
+    Limb* allocateBlock(std::size_t& capacity) override;
+    void deallocateBlock(Limb* block, std::size_t capacity) noexcept override;
+
+private:
+    std::vector<Limb*> chunks;
+    Limb* cursor = nullptr;
+    std::size_t available = 0; /**< свободных слов в текущем куске */
+    LimbAllocator* previous;
+    bool installed;
+};
+
+/**
+ * @brief Делает пул по умолчанию текущим распределителем потока на время своей жизни.
+ *
+ * Нужен там, где новый буфер достаётся уже существующему числу, которое могло быть создано вне
+ * текущей арены: из пула буфер переживёт арену и будет возвращён в пул при уничтожении числа.
+ */
+class LimbPoolScope {
+public:
+    LimbPoolScope() noexcept : previous(LimbAllocator::install(nullptr)) {}
+    ~LimbPoolScope() { LimbAllocator::install(this->previous); }
+    LimbPoolScope(const LimbPoolScope&) = delete;
+    LimbPoolScope& operator=(const LimbPoolScope&) = delete;
+
+private:
+    LimbAllocator* previous;
+};
+
+
+#endif //DMATGCOLLOQUIUM_LIMBALLOCATOR_H
@@ -0,0 +1,188 @@
+#include "LimbArithmetic.h"
+#include "VectorKernels.h"
+
+namespace {
+    // Короче этой длины векторное ядро не окупает подготовку масок
+    constexpr std::size_t VECTOR_KERNEL_MIN_LENGTH = 32;
+}
+
+std::size_t LimbArithmetic::normalizedSize(const Limb *a, std::size_t n) {
+    while (n > 0 && a[n - 1] == 0)
+        --n;
+    return n;
+}
+
+int LimbArithmetic::compare(const Limb *a, const Limb *b, std::size_t n) {
+    // Идём от старших слов к младшим, как при сравнении в столбик
+    while (n-- > 0) {
+        if (a[n] != b[n])
+            return a[n] > b[n] ? 1 : -1;
+    }
+    return 0;
+}
+
+int LimbArithmetic::compare(const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+    if (an != bn)
+        return an > bn ? 1 : -1;
+    return compare(a, b, an);
+}
+
+Limb LimbArithmetic::addN(Limb *r, const Limb *a, const Limb *b, std::size_t n) {
+    if (n >= VECTOR_KERNEL_MIN_LENGTH && VectorKernels::hasAvx2())
+        return VectorKernels::addNAvx2(r, a, b, n, 0);
+    Limb carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        Limb s = a[i] + carry;
+        carry = s < carry;
+        r[i] = s + b[i];
+        carry += r[i] < s;
+    }
+    return carry;
+}
+
+Limb LimbArithmetic::add(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+    Limb carry = addN(r, a, b, bn);
+    return add1(r + bn, a + bn, an - bn, carry);
+}
+
+Limb LimbArithmetic::add1(Limb *r, const Limb *a, std::size_t n, Limb b) {
+    std::size_t i = 0;
+    // Перенос гаснет почти сразу, дальше достаточно скопировать хвост
+    for (; i < n && b; ++i) {
+        r[i] = a[i] + b;
+        b = r[i] < b;
+    }
+    if (r != a) {
+        for (; i < n; ++i)
+            r[i] = a[i];
+    }
+    return b;
+}
+
+Limb LimbArithmetic::subN(Limb *r, const Limb *a, const Limb *b, std::size_t n) {
+    if (n >= VECTOR_KERNEL_MIN_LENGTH && VectorKernels::hasAvx2())
+        return VectorKernels::subNAvx2(r, a, b, n, 0);
+    Limb borrow = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        Limb ai = a[i];
+        Limb d = ai - b[i];
+        Limb borrowOut = ai < b[i];
+        r[i] = d - borrow;
+        borrowOut |= d < borrow;
+        borrow = borrowOut;
+    }
+    return borrow;
+}
+
+Limb LimbArithmetic::sub(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+    Limb borrow = subN(r, a, b, bn);
+    return sub1(r + bn, a + bn, an - bn, borrow);
+}
+
+Limb LimbArithmetic::sub1(Limb *r, const Limb *a, std::size_t n, Limb b) {
+    std::size_t i = 0;
+    for (; i < n && b; ++i) {
+        Limb ai = a[i];
+        r[i] = ai - b;
+        b = ai < b;
+    }
+    if (r != a) {
+        for (; i < n; ++i)
+            r[i] = a[i];
+    }
+    return b;
+}
+
+Limb LimbArithmetic::mul1(Limb *r, const Limb *a, std::size_t n, Limb b) {
+    Limb carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        DoubleLimb p = static_cast<DoubleLimb>(a[i]) * b + carry;
+        r[i] = static_cast<Limb>(p);
+        carry = static_cast<Limb>(p >> LIMB_BITS);
+    }
+    return carry;
+}
+
+Limb LimbArithmetic::addMul1(Limb *r, const Limb *a, std::size_t n, Limb b) {
+    Limb carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        // a*b + r + carry <= (2^64-1)^2 + 2(2^64-1) = 2^128-1, переполнения нет
+        DoubleLimb p = static_cast<DoubleLimb>(a[i]) * b + r[i] + carry;
+        r[i] = static_cast<Limb>(p);
+        carry = static_cast<Limb>(p >> LIMB_BITS);
+    }
+    return carry;
+}
+
+Limb LimbArithmetic::subMul1(Limb *r, const Limb *a, std::size_t n, Limb b) {
+    Limb borrow = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        DoubleLimb p = static_cast<DoubleLimb>(a[i]) * b + borrow;
+        Limb low = static_cast<Limb>(p);
+        borrow = static_cast<Limb>(p >> LIMB_BITS);
+        Limb ri = r[i];
+        r[i] = ri - low;
+        borrow += ri < low;
+    }
+    return borrow;
+}
+
+Limb LimbArithmetic::divRem1(Limb *q, const Limb *a, std::size_t n, Limb d) {
+    Limb rem = 0;
+    for (std::size_t i = n; i-- > 0;) {
+        DoubleLimb cur = (static_cast<DoubleLimb>(rem) << LIMB_BITS) | a[i];
+        q[i] = static_cast<Limb>(cur / d);
+        rem = static_cast<Limb>(cur % d);
+    }
+    return rem;
+}
+
+Limb LimbArithmetic::shiftLeft(Limb *r, const Limb *a, std::size_t n, unsigned s) {
+    if (n == 0)
+        return 0;
+    // Идём сверху вниз, чтобы сдвиг на месте не затирал ещё не прочитанные слова
+    Limb out = a[n - 1] >> (LIMB_BITS - s);
+    for (std::size_t i = n - 1; i > 0; --i)
+        r[i] = (a[i] << s) | (a[i - 1] >> (LIMB_BITS - s));
+    r[0] = a[0] << s;
+    return out;
+}
+
+Limb LimbArithmetic::shiftRight(Limb *r, const Limb *a, std::size_t n, unsigned s) {
+    if (n == 0)
+        return 0;
+    Limb out = a[0] << (LIMB_BITS - s);
+    for (std::size_t i = 0; i + 1 < n; ++i)
+        r[i] = (a[i] >> s) | (a[i + 1] << (LIMB_BITS - s));
+    r[n - 1] = a[n - 1] >> s;
+    return out;
+}
+
+void LimbArithmetic::mulBasecase(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+    r[an] = mul1(r, a, an, b[0]);
+    for (std::size_t j = 1; j < bn; ++j)
+        r[an + j] = addMul1(r + j, a, an, b[j]);
+}
+
+void LimbArithmetic::sqrBasecase(Limb *r, const Limb *a, std::size_t n) {
+    // Произведения a[i] * a[j] при i < j: строка i начинается с разряда 2i + 1, её перенос - в разряд n + i
+    r[0] = 0;
+    r[2 * n - 1] = 0;
+    if (n > 1) {
+        r[n] = mul1(r + 1, a + 1, n - 1, a[0]);
+        for (std::size_t i = 1; i + 1 < n; ++i)
+            r[n + i] = addMul1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+        shiftLeft(r, r, 2 * n, 1);
+    }
+
+    // Квадраты слов ложатся в разряды 2i и 2i + 1
+    Limb carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        DoubleLimb square = static_cast<DoubleLimb>(a[i]) * a[i];
+        DoubleLimb sum = static_cast<DoubleLimb>(r[2 * i]) + static_cast<Limb>(square) + carry;
+        r[2 * i] = static_cast<Limb>(sum);
+        sum = (sum >> LIMB_BITS) + r[2 * i + 1] + static_cast<Limb>(square >> LIMB_BITS);
+        r[2 * i + 1] = static_cast<Limb>(sum);
+        carry = static_cast<Limb>(sum >> LIMB_BITS);
+    }
+}
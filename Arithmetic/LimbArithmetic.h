@@ -0,0 +1,139 @@
+#ifndef DMATGCOLLOQUIUM_LIMBARITHMETIC_H
+#define DMATGCOLLOQUIUM_LIMBARITHMETIC_H
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Машинное слово (limb) длинного числа, основание системы счисления 2^64.
+ */
+using Limb = std::uint64_t;
+
+/**
+ * @brief Двойное машинное слово для промежуточных произведений limb * limb.
+ */
+using DoubleLimb = unsigned __int128;
+
+/**
+ * @brief Низкоуровневые операции над массивами машинных слов.
+ *
+ * Все массивы хранятся в порядке от младшего слова к старшему. Функции не выделяют память:
+ * буфер результата передаёт вызывающий, и его размер оговорён в описании каждой функции.
+ * Если не сказано иное, буфер результата может совпадать с первым операндом (работа на месте).
+ * Длинные addN и subN на процессорах с AVX2 выполняются векторными ядрами (см. VectorKernels).
+ */
+class LimbArithmetic {
+public:
+    static constexpr unsigned LIMB_BITS = 64;
+
+    /**
+     * @brief Наибольшая степень десяти, помещающаяся в одно слово: 10^19.
+     */
+    static constexpr Limb DECIMAL_BASE = 10000000000000000000ULL;
+    static constexpr unsigned DECIMAL_BASE_DIGITS = 19;
+
+    /**
+     * @brief Длина массива без старших нулевых слов.
+     */
+    static std::size_t normalizedSize(const Limb* a, std::size_t n);
+
+    /**
+     * @brief Сравнение массивов одинаковой длины n: -1, 0 или 1.
+     */
+    static int compare(const Limb* a, const Limb* b, std::size_t n);
+
+    /**
+     * @brief Сравнение нормализованных массивов разной длины: -1, 0 или 1.
+     */
+    static int compare(const Limb* a, std::size_t an, const Limb* b, std::size_t bn);
+
+    /**
+     * @brief r[0..n) = a + b, возвращает перенос из старшего слова.
+     */
+    static Limb addN(Limb* r, const Limb* a, const Limb* b, std::size_t n);
+
+    /**
+     * @brief r[0..an) = a + b при an >= bn, возвращает перенос.
+     */
+    static Limb add(Limb* r, const Limb* a, std::size_t an, const Limb* b, std::size_t bn);
+
+    /**
+     * @brief r[0..n) = a + b, где b - одно слово, возвращает перенос.
+     */
+    static Limb add1(Limb* r, const Limb* a, std::size_t n, Limb b);
+
+    /**
+     * @brief r[0..n) = a - b, возвращает заём из старшего слова.
+     */
+    static Limb subN(Limb* r, const Limb* a, const Limb* b, std::size_t n);
+
+    /**
+     * @brief r[0..an) = a - b при an >= bn, возвращает заём.
+     */
+    static Limb sub(Limb* r, const Limb* a, std::size_t an, const Limb* b, std::size_t bn);
+
+    /**
+     * @brief r[0..n) = a - b, где b - одно слово, возвращает заём.
+     */
+    static Limb sub1(Limb* r, const Limb* a, std::size_t n, Limb b);
+
+    /**
+     * @brief r[0..n) = a * b, возвращает старшее слово произведения.
+     */
+    static Limb mul1(Limb* r, const Limb* a, std::size_t n, Limb b);
+
+    /**
+     * @brief r[0..n) += a * b, возвращает слово переноса.
+     */
+    static Limb addMul1(Limb* r, const Limb* a, std::size_t n, Limb b);
+
+    /**
+     * @brief r[0..n) -= a * b, возвращает слово заёма.
+     */
+    static Limb subMul1(Limb* r, const Limb* a, std::size_t n, Limb b);
+
+    /**
+     * @brief q[0..n) = a / d, возвращает остаток. Буфер q может совпадать с a.
+     */
+    static Limb divRem1(Limb* q, const Limb* a, std::size_t n, Limb d);
+
+    /**
+     * @brief r[0..n) = a << s при 0 < s < 64, возвращает выдвинутые старшие биты.
+     */
+    static Limb shiftLeft(Limb* r, const Limb* a, std::size_t n, unsigned s);
+
+    /**
+     * @brief r[0..n) = a >> s при 0 < s < 64, возвращает выдвинутые младшие биты (в старших разрядах слова).
+     */
+    static Limb shiftRight(Limb* r, const Limb* a, std::size_t n, unsigned s);
+
+    /**
+     * @brief Умножение в столбик: r[0..an+bn) = a * b, an >= bn > 0. Буфер r не должен пересекаться с a и b.
+     */
+    static void mulBasecase(Limb* r, const Limb* a, std::size_t an, const Limb* b, std::size_t bn);
+
+    /**
+     * @brief Возведение в квадрат в столбик: r[0..2n) = a * a, n > 0. Буфер r не должен пересекаться с a.
+     *
+     * Каждое произведение a[i] * a[j] при i != j встречается в квадрате дважды, поэтому считается
+     * один раз, сумма удваивается сдвигом, и к ней добавляются квадраты слов: около n^2 / 2 умножений.
+     */
+    static void sqrBasecase(Limb* r, const Limb* a, std::size_t n);
+
+    /**
+     * @brief Количество ведущих нулевых бит ненулевого слова.
+     */
+    static unsigned countLeadingZeros(Limb x) {
+        return static_cast<unsigned>(__builtin_clzll(x));
+    }
+
+    /**
+     * @brief Количество младших нулевых бит ненулевого слова.
+     */
+    static unsigned countTrailingZeros(Limb x) {
+        return static_cast<unsigned>(__builtin_ctzll(x));
+    }
+};
+
+
+#endif //DMATGCOLLOQUIUM_LIMBARITHMETIC_H
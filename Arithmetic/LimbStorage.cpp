@@ -0,0 +1,126 @@
+#include "LimbStorage.h"
+#include "LimbAllocator.h"
+#include <algorithm>
+#include <cstring>
+
+LimbStorage::LimbStorage(const LimbStorage &other) : length(0), allocated(INLINE_CAPACITY) {
+    this->copyFrom(other);
+}
+
+LimbStorage::LimbStorage(LimbStorage &&other) noexcept : length(other.length), allocated(other.allocated) {
+    if (other.isInline()) {
+        std::memcpy(this->inlineLimbs, other.inlineLimbs, sizeof(this->inlineLimbs));
+    } else {
+        // Буфер в куче забираем целиком, источник возвращается к встроенному хранилищу
+        this->heapLimbs = other.heapLimbs;
+        other.allocated = INLINE_CAPACITY;
+    }
+    other.length = 0;
+}
+
+LimbStorage &LimbStorage::operator=(const LimbStorage &other) {
+    if (this != &other)
+        this->copyFrom(other);
+    return *this;
+}
+
+LimbStorage &LimbStorage::operator=(LimbStorage &&other) noexcept {
+    if (this != &other) {
+        this->release();
+        this->length = other.length;
+        this->allocated = other.allocated;
+        if (other.isInline()) {
+            std::memcpy(this->inlineLimbs, other.inlineLimbs, sizeof(this->inlineLimbs));
+        } else {
+            this->heapLimbs = other.heapLimbs;
+            other.allocated = INLINE_CAPACITY;
+        }
+        other.length = 0;
+    }
+    return *this;
+}
+
+LimbStorage &LimbStorage::operator=(const std::vector<Limb> &other) {
+    this->assign(other.data(), other.size());
+    return *this;
+}
+
+LimbStorage::~LimbStorage() {
+    this->release();
+}
+
+void LimbStorage::assign(const Limb *a, std::size_t n) {
+    // Старое содержимое не нужно, поэтому при нехватке места копировать его в новый буфер незачем,
+    // а разделяемый буфер проще отпустить, чем копировать
+    this->length = 0;
+    if (!this->isInline() && this->isShared())
+        this->release();
+    if (n > this->allocated)
+        this->grow(n);
+    if (n > 0)
+        std::memcpy(this->data(), a, n * sizeof(Limb));
+    this->length = n;
+}
+
+void LimbStorage::reserve(std::size_t n) {
+    if (n > this->allocated)
+        this->grow(n);
+}
+
+void LimbStorage::resize(std::size_t n, Limb value) {
+    if (n > this->allocated)
+        this->grow(std::max(n, 2 * this->allocated));
+    if (n > this->length)
+        std::fill(this->data() + this->length, this->data() + n, value);
+    this->length = n;
+}
+
+void LimbStorage::push_back(Limb value) {
+    if (this->length == this->allocated)
+        this->grow(2 * this->allocated);
+    this->data()[this->length++] = value;
+}
+
+// Делит буфер other, если он выделен текущим распределителем, иначе копирует слова
+void LimbStorage::copyFrom(const LimbStorage &other) {
+    if (other.isInline() || LimbAllocator::owner(other.heapLimbs) != &LimbAllocator::current()) {
+        this->assign(other.data(), other.length);
+        return;
+    }
+    LimbAllocator::references(other.heapLimbs).fetch_add(1, std::memory_order_relaxed);
+    this->release();
+    this->heapLimbs = other.heapLimbs;
+    this->allocated = other.allocated;
+    this->length = other.length;
+}
+
+bool LimbStorage::isShared() const noexcept {
+    return LimbAllocator::references(this->heapLimbs).load(std::memory_order_acquire) > 1;
+}
+
+// Заменяет разделяемый буфер собственной копией той же ёмкости
+void LimbStorage::unshare() {
+    std::size_t n = this->allocated;
+    Limb *buffer = LimbAllocator::allocate(n);
+    if (this->length > 0)
+        std::memcpy(buffer, this->heapLimbs, this->length * sizeof(Limb));
+    this->release();
+    this->heapLimbs = buffer;
+    this->allocated = n;
+}
+
+// Переносит содержимое в буфер не меньше чем из n слов от LimbAllocator, n больше текущей ёмкости
+void LimbStorage::grow(std::size_t n) {
+    Limb *buffer = LimbAllocator::allocate(n);
+    if (this->length > 0)
+        std::memcpy(buffer, this->isInline() ? this->inlineLimbs : this->heapLimbs, this->length * sizeof(Limb));
+    this->release();
+    this->heapLimbs = buffer;
+    this->allocated = n;
+}
+
+void LimbStorage::release() noexcept {
+    if (!this->isInline() && LimbAllocator::references(this->heapLimbs).fetch_sub(1, std::memory_order_acq_rel) == 1)
+        LimbAllocator::deallocate(this->heapLimbs, this->allocated);
+    this->allocated = INLINE_CAPACITY;
+}
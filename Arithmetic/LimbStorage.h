@@ -0,0 +1,81 @@
+#ifndef DMATGCOLLOQUIUM_LIMBSTORAGE_H
+#define DMATGCOLLOQUIUM_LIMBSTORAGE_H
+
+#include "LimbArithmetic.h"
+#include <vector>
+
+/**
+ * @brief Массив слов длинного числа с местом под короткие числа внутри объекта.
+ *
+ * Числа длиной до INLINE_CAPACITY слов хранятся прямо в объекте и не выделяют память,
+ * при росте содержимое переносится в буфер от LimbAllocator. Интерфейс повторяет нужную часть std::vector:
+ * новые слова при resize заполняются нулями, emplace-операций и итераторов вставки нет.
+ *
+ * Буфер копируется при записи: копия объекта только увеличивает счётчик ссылок буфера, а собственная
+ * копия слов делается при первом обращении через неконстантный доступ (data, operator[], back, begin, end)
+ * или при изменении размера. Поэтому указатель, полученный через константный доступ, нельзя хранить
+ * после неконстантного обращения к тому же объекту. Буферы чужого распределителя (например, арены,
+ * из которой результат копируется наружу) не разделяются, а копируются сразу.
+ */
+class LimbStorage {
+public:
+    static constexpr std::size_t INLINE_CAPACITY = 2;
+
+    LimbStorage() noexcept : length(0), allocated(INLINE_CAPACITY) {}
+    LimbStorage(const LimbStorage& other);
+    LimbStorage(LimbStorage&& other) noexcept;
+    LimbStorage& operator=(const LimbStorage& other);
+    LimbStorage& operator=(LimbStorage&& other) noexcept;
+    ~LimbStorage();
+
+    std::size_t size() const noexcept { return length; }
+    std::size_t capacity() const noexcept { return allocated; }
+    bool empty() const noexcept { return length == 0; }
+    bool isInline() const noexcept { return allocated == INLINE_CAPACITY; }
+
+    Limb* data() {
+        if (isInline())
+            return inlineLimbs;
+        if (isShared())
+            unshare();
+        return heapLimbs;
+    }
+    const Limb* data() const noexcept { return isInline() ? inlineLimbs : heapLimbs; }
+    Limb& operator[](std::size_t i) { return data()[i]; }
+    const Limb& operator[](std::size_t i) const noexcept { return data()[i]; }
+    Limb& back() { return data()[length - 1]; }
+    const Limb& back() const noexcept { return data()[length - 1]; }
+    Limb* begin() { return data(); }
+    Limb* end() { return data() + length; }
+    const Limb* begin() const noexcept { return data(); }
+    const Limb* end() const noexcept { return data() + length; }
+
+    void reserve(std::size_t n);
+    void resize(std::size_t n, Limb value = 0);
+    void push_back(Limb value);
+    void clear() noexcept { length = 0; }
+
+    /**
+     * @brief Заменяет содержимое на a[0..n), буфер a не должен лежать внутри этого объекта.
+     */
+    void assign(const Limb* a, std::size_t n);
+    LimbStorage& operator=(const std::vector<Limb>& other);
+    std::vector<Limb> toVector() const { return std::vector<Limb>(begin(), end()); }
+
+private:
+    std::size_t length;
+    std::size_t allocated; /**< INLINE_CAPACITY - слова внутри объекта, иначе размер буфера от LimbAllocator */
+    union {
+        Limb inlineLimbs[INLINE_CAPACITY];
+        Limb* heapLimbs;
+    };
+
+    bool isShared() const noexcept;
+    void unshare();
+    void copyFrom(const LimbStorage& other);
+    void grow(std::size_t n);
+    void release() noexcept;
+};
+
+
+#endif //DMATGCOLLOQUIUM_LIMBSTORAGE_H
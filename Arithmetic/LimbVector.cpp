@@ -0,0 +1,91 @@
+#include "LimbVector.h"
+#include "Multiplication.h"
+#include "Division.h"
+#include <algorithm>
+
+void LimbVector::trim(std::vector<Limb> &x) {
+    x.resize(LimbArithmetic::normalizedSize(x.data(), x.size()));
+}
+
+int LimbVector::compare(const std::vector<Limb> &x, const std::vector<Limb> &y) {
+    return LimbArithmetic::compare(x.data(), x.size(), y.data(), y.size());
+}
+
+std::vector<Limb> LimbVector::multiply(const Limb *x, std::size_t xn, const Limb *y, std::size_t yn) {
+    xn = LimbArithmetic::normalizedSize(x, xn);
+    yn = LimbArithmetic::normalizedSize(y, yn);
+    if (xn == 0 || yn == 0)
+        return {};
+    std::vector<Limb> result(xn + yn);
+    if (xn >= yn)
+        Multiplication::multiply(result.data(), x, xn, y, yn);
+    else
+        Multiplication::multiply(result.data(), y, yn, x, xn);
+    trim(result);
+    return result;
+}
+
+std::vector<Limb> LimbVector::multiply(const std::vector<Limb> &x, const std::vector<Limb> &y) {
+    return multiply(x.data(), x.size(), y.data(), y.size());
+}
+
+void LimbVector::addInPlace(std::vector<Limb> &x, const Limb *y, std::size_t yn) {
+    if (x.size() < yn)
+        x.resize(yn, 0);
+    x.push_back(0);
+    LimbArithmetic::add(x.data(), x.data(), x.size(), y, yn);
+    trim(x);
+}
+
+void LimbVector::addInPlace(std::vector<Limb> &x, const std::vector<Limb> &y) {
+    addInPlace(x, y.data(), y.size());
+}
+
+void LimbVector::subtractInPlace(std::vector<Limb> &x, const Limb *y, std::size_t yn) {
+    LimbArithmetic::sub(x.data(), x.data(), x.size(), y, LimbArithmetic::normalizedSize(y, yn));
+    trim(x);
+}
+
+void LimbVector::subtractInPlace(std::vector<Limb> &x, const std::vector<Limb> &y) {
+    subtractInPlace(x, y.data(), y.size());
+}
+
+void LimbVector::increment(std::vector<Limb> &x) {
+    x.push_back(0);
+    LimbArithmetic::add1(x.data(), x.data(), x.size(), 1);
+    trim(x);
+}
+
+void LimbVector::decrement(std::vector<Limb> &x) {
+    LimbArithmetic::sub1(x.data(), x.data(), x.size(), 1);
+    trim(x);
+}
+
+std::vector<Limb> LimbVector::shiftRightLimbs(const std::vector<Limb> &x, std::size_t k) {
+    if (k >= x.size())
+        return {};
+    return std::vector<Limb>(x.begin() + static_cast<std::ptrdiff_t>(k), x.end());
+}
+
+void LimbVector::divideRemainder(const std::vector<Limb> &x, const std::vector<Limb> &y,
+                                 std::vector<Limb> *q, std::vector<Limb> *r) {
+    if (compare(x, y) < 0) {
+        if (q)
+            q->clear();
+        if (r)
+            *r = x;
+        return;
+    }
+    std::vector<Limb> quotient(q ? x.size() - y.size() + 1 : 0);
+    std::vector<Limb> rest(r ? y.size() : 0);
+    Division::divideRemainder(q ? quotient.data() : nullptr, r ? rest.data() : nullptr,
+                              x.data(), x.size(), y.data(), y.size());
+    if (q) {
+        trim(quotient);
+        *q = std::move(quotient);
+    }
+    if (r) {
+        trim(rest);
+        *r = std::move(rest);
+    }
+}
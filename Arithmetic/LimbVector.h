@@ -0,0 +1,51 @@
+#ifndef DMATGCOLLOQUIUM_LIMBVECTOR_H
+#define DMATGCOLLOQUIUM_LIMBVECTOR_H
+
+#include "LimbArithmetic.h"
+#include <vector>
+
+/**
+ * @brief Операции над длинными числами в виде std::vector<Limb> для промежуточных значений алгоритмов.
+ *
+ * Все векторы хранятся без старших нулевых слов (ноль - пустой вектор), функции сохраняют этот инвариант.
+ */
+class LimbVector {
+public:
+    static void trim(std::vector<Limb>& x);
+    static int compare(const std::vector<Limb>& x, const std::vector<Limb>& y);
+
+    /**
+     * @brief Произведение через движок умножения, множители могут содержать старшие нули.
+     */
+    static std::vector<Limb> multiply(const Limb* x, std::size_t xn, const Limb* y, std::size_t yn);
+    static std::vector<Limb> multiply(const std::vector<Limb>& x, const std::vector<Limb>& y);
+
+    /**
+     * @brief x += y
+     */
+    static void addInPlace(std::vector<Limb>& x, const Limb* y, std::size_t yn);
+    static void addInPlace(std::vector<Limb>& x, const std::vector<Limb>& y);
+
+    /**
+     * @brief x -= y при x >= y
+     */
+    static void subtractInPlace(std::vector<Limb>& x, const Limb* y, std::size_t yn);
+    static void subtractInPlace(std::vector<Limb>& x, const std::vector<Limb>& y);
+
+    static void increment(std::vector<Limb>& x);
+    static void decrement(std::vector<Limb>& x);
+
+    /**
+     * @brief x / B^k, то есть x без k младших слов.
+     */
+    static std::vector<Limb> shiftRightLimbs(const std::vector<Limb>& x, std::size_t k);
+
+    /**
+     * @brief Деление с остатком через движок деления, делитель ненулевой. Любой из q и r может быть nullptr.
+     */
+    static void divideRemainder(const std::vector<Limb>& x, const std::vector<Limb>& y,
+                                std::vector<Limb>* q, std::vector<Limb>* r);
+};
+
+
+#endif //DMATGCOLLOQUIUM_LIMBVECTOR_H
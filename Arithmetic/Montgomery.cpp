@@ -0,0 +1,73 @@
+#include "Montgomery.h"
+#include "LimbVector.h"
+#include "Multiplication.h"
+#include <algorithm>
+
+MontgomeryContext::MontgomeryContext(std::vector<Limb> modulus) : modulus(std::move(modulus)) {
+    const std::size_t n = this->modulus.size();
+    // m * m = 1 mod 8 для нечётного m, каждая итерация Ньютона удваивает число верных бит
+    const Limb m0 = this->modulus[0];
+    Limb inverse = m0;
+    for (int i = 0; i < 5; ++i)
+        inverse *= 2 - m0 * inverse;
+    this->negativeInverse = 0 - inverse;
+
+    // R^2 mod m - единственное деление, которое нужно контексту
+    std::vector<Limb> r2(2 * n + 1, 0);
+    r2[2 * n] = 1;
+    LimbVector::divideRemainder(r2, this->modulus, nullptr, &this->rSquared);
+    this->rSquared.resize(n, 0);
+    this->product.resize(2 * n + 1);
+}
+
+std::vector<Limb> MontgomeryContext::toMontgomery(const std::vector<Limb> &x) const {
+    std::vector<Limb> reduced;
+    if (LimbVector::compare(x, this->modulus) >= 0)
+        LimbVector::divideRemainder(x, this->modulus, nullptr, &reduced);
+    else
+        reduced = x;
+    reduced.resize(this->modulus.size(), 0);
+    // (x * R^2) * R^(-1) = x * R
+    this->multiply(reduced, reduced, this->rSquared);
+    return reduced;
+}
+
+std::vector<Limb> MontgomeryContext::fromMontgomery(const std::vector<Limb> &x) const {
+    std::fill(this->product.begin(), this->product.end(), 0);
+    std::copy(x.begin(), x.end(), this->product.begin());
+    std::vector<Limb> result;
+    this->reduce(result);
+    LimbVector::trim(result);
+    return result;
+}
+
+std::vector<Limb> MontgomeryContext::one() const {
+    return this->toMontgomery({1});
+}
+
+void MontgomeryContext::multiply(std::vector<Limb> &r, const std::vector<Limb> &a, const std::vector<Limb> &b) const {
+    const std::size_t n = this->modulus.size();
+    // Один и тот же массив в обоих множителях движок умножения возводит в квадрат
+    Multiplication::multiply(this->product.data(), a.data(), n, b.data(), n);
+    this->product[2 * n] = 0;
+    this->reduce(r);
+}
+
+void MontgomeryContext::square(std::vector<Limb> &r, const std::vector<Limb> &a) const {
+    this->multiply(r, a, a);
+}
+
+void MontgomeryContext::reduce(std::vector<Limb> &r) const {
+    const std::size_t n = this->modulus.size();
+    Limb *t = this->product.data();
+    // Каждый шаг прибавляет q * m * B^i с таким q, что слово i становится нулевым
+    for (std::size_t i = 0; i < n; ++i) {
+        const Limb q = t[i] * this->negativeInverse;
+        const Limb carry = LimbArithmetic::addMul1(t + i, this->modulus.data(), n, q);
+        LimbArithmetic::add1(t + i + n, t + i + n, n + 1 - i, carry);
+    }
+    // Результат t[n..2n] меньше 2m, достаточно одного вычитания
+    if (t[2 * n] != 0 || LimbArithmetic::compare(t + n, this->modulus.data(), n) >= 0)
+        LimbArithmetic::subN(t + n, t + n, this->modulus.data(), n);
+    r.assign(t + n, t + 2 * n);
+}
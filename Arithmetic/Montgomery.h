@@ -0,0 +1,61 @@
+#ifndef DMATGCOLLOQUIUM_MONTGOMERY_H
+#define DMATGCOLLOQUIUM_MONTGOMERY_H
+
+#include "LimbArithmetic.h"
+#include <vector>
+
+/**
+ * @brief Арифметика по нечётному модулю m длины n в форме Монтгомери.
+ *
+ * Число x хранится как x * R mod m, где R = B^n. Произведение таких чисел приводится обратно
+ * редукцией Монтгомери (REDC): к произведению прибавляется кратное m, обнуляющее младшие n слов,
+ * и они отбрасываются. Для этого нужна только константа -m^(-1) mod B, посчитанная один раз
+ * в конструкторе, так что модульное умножение обходится без деления.
+ *
+ * Все значения в форме Монтгомери - массивы ровно из n слов (возможны старшие нули) и меньше m.
+ * Контекст держит рабочий буфер, поэтому один объект нельзя использовать из нескольких потоков сразу.
+ */
+class MontgomeryContext {
+public:
+    /**
+     * @brief Контекст для нечётного модуля m > 1 без старших нулевых слов.
+     */
+    explicit MontgomeryContext(std::vector<Limb> modulus);
+
+    std::size_t size() const noexcept { return modulus.size(); }
+
+    /**
+     * @brief x * R mod m для любого нормализованного x.
+     */
+    std::vector<Limb> toMontgomery(const std::vector<Limb>& x) const;
+
+    /**
+     * @brief Обычное значение числа в форме Монтгомери, без старших нулевых слов.
+     */
+    std::vector<Limb> fromMontgomery(const std::vector<Limb>& x) const;
+
+    /**
+     * @brief R mod m - единица в форме Монтгомери.
+     */
+    std::vector<Limb> one() const;
+
+    /**
+     * @brief r = a * b * R^(-1) mod m. Буфер r может совпадать с a или b.
+     */
+    void multiply(std::vector<Limb>& r, const std::vector<Limb>& a, const std::vector<Limb>& b) const;
+    void square(std::vector<Limb>& r, const std::vector<Limb>& a) const;
+
+private:
+    std::vector<Limb> modulus;
+    Limb negativeInverse; /**< -m^(-1) mod B */
+    std::vector<Limb> rSquared; /**< R^2 mod m, n слов */
+    mutable std::vector<Limb> product; /**< рабочий буфер произведения из 2n + 1 слов */
+
+    /**
+     * @brief r = product * R^(-1) mod m, product < m * R.
+     */
+    void reduce(std::vector<Limb>& r) const;
+};
+
+
+#endif //DMATGCOLLOQUIUM_MONTGOMERY_H
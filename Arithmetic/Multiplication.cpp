@@ -0,0 +1,285 @@
+#include "Multiplication.h"
+#include "NumberTheoreticTransform.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+    MultiplicationThresholds currentThresholds;
+
+    // Знаковое длинное число для промежуточных значений Тоом-3: в точке -1 и при интерполяции
+    // коэффициенты бывают отрицательными.
+    struct SignedLimbs {
+        std::vector<Limb> magnitude; // без старших нулевых слов
+        bool negative = false;
+    };
+
+    void normalize(SignedLimbs &x) {
+        x.magnitude.resize(LimbArithmetic::normalizedSize(x.magnitude.data(), x.magnitude.size()));
+        if (x.magnitude.empty())
+            x.negative = false;
+    }
+
+    SignedLimbs fromRange(const Limb *a, std::size_t n) {
+        SignedLimbs result;
+        result.magnitude.assign(a, a + LimbArithmetic::normalizedSize(a, n));
+        return result;
+    }
+
+    // x + y или x - y (при negateY)
+    SignedLimbs addSigned(const SignedLimbs &x, const SignedLimbs &y, bool negateY) {
+        bool yNegative = y.negative != negateY && !y.magnitude.empty();
+        const std::vector<Limb> &xm = x.magnitude;
+        const std::vector<Limb> &ym = y.magnitude;
+        SignedLimbs result;
+        if (x.negative == yNegative) {
+            const std::vector<Limb> &longer = xm.size() >= ym.size() ? xm : ym;
+            const std::vector<Limb> &shorter = xm.size() >= ym.size() ? ym : xm;
+            result.magnitude.resize(longer.size() + 1);
+            result.magnitude[longer.size()] = LimbArithmetic::add(result.magnitude.data(), longer.data(), longer.size(),
+                                                                  shorter.data(), shorter.size());
+            result.negative = x.negative;
+        } else {
+            int c = LimbArithmetic::compare(xm.data(), xm.size(), ym.data(), ym.size());
+            const std::vector<Limb> &larger = c >= 0 ? xm : ym;
+            const std::vector<Limb> &smaller = c >= 0 ? ym : xm;
+            result.magnitude.resize(larger.size());
+            LimbArithmetic::sub(result.magnitude.data(), larger.data(), larger.size(), smaller.data(), smaller.size());
+            result.negative = c >= 0 ? x.negative : yNegative;
+        }
+        normalize(result);
+        return result;
+    }
+
+    SignedLimbs multiplySigned(const SignedLimbs &x, const SignedLimbs &y) {
+        SignedLimbs result;
+        if (x.magnitude.empty() || y.magnitude.empty())
+            return result;
+        const std::vector<Limb> &longer = x.magnitude.size() >= y.magnitude.size() ? x.magnitude : y.magnitude;
+        const std::vector<Limb> &shorter = x.magnitude.size() >= y.magnitude.size() ? y.magnitude : x.magnitude;
+        result.magnitude.resize(longer.size() + shorter.size());
+        Multiplication::multiply(result.magnitude.data(), longer.data(), longer.size(), shorter.data(), shorter.size());
+        result.negative = x.negative != y.negative;
+        normalize(result);
+        return result;
+    }
+
+    void multiplyBySmall(SignedLimbs &x, Limb m) {
+        Limb carry = LimbArithmetic::mul1(x.magnitude.data(), x.magnitude.data(), x.magnitude.size(), m);
+        if (carry)
+            x.magnitude.push_back(carry);
+    }
+
+    // Деление нацело, остаток по построению интерполяции равен нулю
+    void divideExactBySmall(SignedLimbs &x, Limb d) {
+        LimbArithmetic::divRem1(x.magnitude.data(), x.magnitude.data(), x.magnitude.size(), d);
+        normalize(x);
+    }
+
+    // r[0..xn) = |x - y| при xn >= yn, возвращает true, если x < y
+    bool absoluteDifference(Limb *r, const Limb *x, std::size_t xn, const Limb *y, std::size_t yn) {
+        std::size_t xLen = LimbArithmetic::normalizedSize(x, xn);
+        std::size_t yLen = LimbArithmetic::normalizedSize(y, yn);
+        if (LimbArithmetic::compare(x, xLen, y, yLen) >= 0) {
+            LimbArithmetic::sub(r, x, xn, y, yn);
+            return false;
+        }
+        LimbArithmetic::sub(r, y, yLen, x, xLen);
+        std::fill(r + yLen, r + xn, 0);
+        return true;
+    }
+
+    void addAt(Limb *r, std::size_t rn, std::size_t offset, const SignedLimbs &x) {
+        if (x.magnitude.empty())
+            return;
+        LimbArithmetic::add(r + offset, r + offset, rn - offset, x.magnitude.data(), x.magnitude.size());
+    }
+}
+
+MultiplicationThresholds Multiplication::getThresholds() {
+    return currentThresholds;
+}
+
+void Multiplication::setThresholds(const MultiplicationThresholds &thresholds) {
+    // Карацуба режет операнды пополам, поэтому порог меньше 2 слов привёл бы к бесконечной рекурсии
+    currentThresholds.karatsuba = std::max<std::size_t>(thresholds.karatsuba, 2);
+    currentThresholds.toom3 = std::max<std::size_t>(thresholds.toom3, 3);
+    currentThresholds.ntt = std::max<std::size_t>(thresholds.ntt, 1);
+    currentThresholds.karatsubaSquare = std::max<std::size_t>(thresholds.karatsubaSquare, 2);
+    currentThresholds.parallelChunk = std::max<std::size_t>(thresholds.parallelChunk, 1);
+}
+
+// Потоков не больше, чем есть в пуле, и не больше, чем кусков по parallelChunk слов в произведении
+std::size_t Multiplication::parallelism(std::size_t resultSize) {
+    return std::max<std::size_t>(std::min(ThreadPool::getThreadCount(), resultSize / currentThresholds.parallelChunk), 1);
+}
+
+void Multiplication::multiply(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+    if (a == b && an == bn) {
+        square(r, a, an);
+    } else if (bn < currentThresholds.karatsuba) {
+        LimbArithmetic::mulBasecase(r, a, an, b, bn);
+    } else if (bn >= currentThresholds.ntt) {
+        NumberTheoreticTransform::multiply(r, a, an, b, bn, parallelism(an + bn));
+    } else if (bn <= (an + 1) / 2) {
+        multiplyUnbalanced(r, a, an, b, bn);
+    } else if (bn < currentThresholds.toom3) {
+        karatsuba(r, a, an, b, bn);
+    } else {
+        toom3(r, a, an, b, bn);
+    }
+}
+
+void Multiplication::square(Limb *r, const Limb *a, std::size_t n) {
+    if (n < currentThresholds.karatsubaSquare) {
+        LimbArithmetic::sqrBasecase(r, a, n);
+    } else if (n >= currentThresholds.ntt) {
+        NumberTheoreticTransform::square(r, a, n, parallelism(2 * n));
+    } else if (n < currentThresholds.toom3) {
+        karatsubaSquare(r, a, n);
+    } else {
+        toom3(r, a, n, a, n);
+    }
+}
+
+// Длинный множитель режется на куски длины bn, каждый кусок умножается как сбалансированная пара
+void Multiplication::multiplyUnbalanced(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+    std::fill(r, r + an + bn, 0);
+    std::vector<Limb> piece(2 * bn);
+    for (std::size_t offset = 0; offset < an; offset += bn) {
+        std::size_t len = std::min(bn, an - offset);
+        if (len == bn)
+            multiply(piece.data(), a + offset, len, b, bn);
+        else
+            multiply(piece.data(), b, bn, a + offset, len);
+        LimbArithmetic::add(r + offset, r + offset, an + bn - offset, piece.data(), len + bn);
+    }
+}
+
+// Вычитательный вариант Карацубы: a0*b1 + a1*b0 = a0*b0 + a1*b1 - (a0 - a1)*(b0 - b1).
+// Разности берутся по модулю, поэтому все промежуточные значения помещаются в h слов без переносов.
+void Multiplication::karatsuba(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+    const std::size_t h = (an + 1) / 2;
+    const std::size_t a1n = an - h;
+    const std::size_t b1n = bn - h; // > 0, так как bn > (an + 1) / 2
+    const Limb *a1 = a + h;
+    const Limb *b1 = b + h;
+
+    // |a0 - a1| и |b0 - b1|, старшие части дополняются нулями до h слов
+    std::vector<Limb> scratch(4 * h + 1);
+    Limb *diffA = scratch.data();
+    Limb *diffB = diffA + h;
+    const bool negativeA = absoluteDifference(diffA, a, h, a1, a1n);
+    const bool negativeB = absoluteDifference(diffB, b, h, b1, b1n);
+
+    // z0 = a0 * b0 в r[0..2h), z2 = a1 * b1 в r[2h..an+bn); a1n >= b1n, так как an >= bn
+    multiply(r, a, h, b, h);
+    multiply(r + 2 * h, a1, a1n, b1, b1n);
+
+    // middle = z0 + z2 -+ |a0 - a1| * |b0 - b1|
+    std::vector<Limb> middle(2 * h + 1);
+    const std::size_t z2n = a1n + b1n;
+    middle[2 * h] = LimbArithmetic::add(middle.data(), r, 2 * h, r + 2 * h, z2n);
+    multiply(scratch.data() + 2 * h, diffA, h, diffB, h);
+    if (negativeA == negativeB)
+        LimbArithmetic::sub(middle.data(), middle.data(), 2 * h + 1, scratch.data() + 2 * h, 2 * h);
+    else
+        LimbArithmetic::add(middle.data(), middle.data(), 2 * h + 1, scratch.data() + 2 * h, 2 * h);
+
+    // Средний коэффициент меньше B^(an+bn-h), лишние старшие слова middle нулевые
+    std::size_t middleLen = std::min(2 * h + 1, an + bn - h);
+    middleLen = LimbArithmetic::normalizedSize(middle.data(), middleLen);
+    LimbArithmetic::add(r + h, r + h, an + bn - h, middle.data(), middleLen);
+}
+
+// Квадрат по Карацубе: 2 * a0 * a1 = a0^2 + a1^2 - (a0 - a1)^2, все три части - квадраты
+void Multiplication::karatsubaSquare(Limb *r, const Limb *a, std::size_t n) {
+    const std::size_t h = (n + 1) / 2;
+    const std::size_t a1n = n - h;
+    const Limb *a1 = a + h;
+
+    std::vector<Limb> scratch(3 * h);
+    Limb *diff = scratch.data();
+    absoluteDifference(diff, a, h, a1, a1n);
+
+    // z0 = a0^2 в r[0..2h), z2 = a1^2 в r[2h..2n)
+    square(r, a, h);
+    square(r + 2 * h, a1, a1n);
+
+    // middle = z0 + z2 - (a0 - a1)^2 >= 0
+    std::vector<Limb> middle(2 * h + 1);
+    middle[2 * h] = LimbArithmetic::add(middle.data(), r, 2 * h, r + 2 * h, 2 * a1n);
+    square(scratch.data() + h, diff, h);
+    LimbArithmetic::sub(middle.data(), middle.data(), 2 * h + 1, scratch.data() + h, 2 * h);
+
+    std::size_t middleLen = std::min(2 * h + 1, 2 * n - h);
+    middleLen = LimbArithmetic::normalizedSize(middle.data(), middleLen);
+    LimbArithmetic::add(r + h, r + h, 2 * n - h, middle.data(), middleLen);
+}
+
+// Тоом-3 в точках 0, 1, -1, -2, бесконечность, интерполяция по последовательности Бодрато.
+// При возведении в квадрат значения второго множителя совпадают с первыми, и поточечные
+// произведения тоже становятся квадратами.
+void Multiplication::toom3(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn) {
+    const std::size_t k = (an + 2) / 3;
+    auto part = [k](const Limb *x, std::size_t xn, std::size_t index) {
+        std::size_t from = std::min(xn, index * k);
+        std::size_t to = index == 2 ? xn : std::min(xn, (index + 1) * k);
+        return fromRange(x + from, to - from);
+    };
+    const SignedLimbs a0 = part(a, an, 0), a1 = part(a, an, 1), a2 = part(a, an, 2);
+    const SignedLimbs b0 = part(b, bn, 0), b1 = part(b, bn, 1), b2 = part(b, bn, 2);
+
+    // Значения многочленов в точках
+    SignedLimbs ta = addSigned(a0, a2, false);
+    SignedLimbs tb = addSigned(b0, b2, false);
+    const SignedLimbs pa1 = addSigned(ta, a1, false);
+    const SignedLimbs pb1 = addSigned(tb, b1, false);
+    const SignedLimbs pam1 = addSigned(ta, a1, true);
+    const SignedLimbs pbm1 = addSigned(tb, b1, true);
+    SignedLimbs pam2 = addSigned(pam1, a2, false);
+    multiplyBySmall(pam2, 2);
+    pam2 = addSigned(pam2, a0, true);
+    SignedLimbs pbm2 = addSigned(pbm1, b2, false);
+    multiplyBySmall(pbm2, 2);
+    pbm2 = addSigned(pbm2, b0, true);
+
+    // Поточечные произведения
+    const bool squaring = a == b && an == bn;
+    const SignedLimbs *factors[5][2] = {{&a0, &b0}, {&pa1, &pb1}, {&pam1, &pbm1}, {&pam2, &pbm2}, {&a2, &b2}};
+    SignedLimbs products[5];
+    auto pointwise = [&](std::size_t i) {
+        products[i] = multiplySigned(*factors[i][0], squaring ? *factors[i][0] : *factors[i][1]);
+    };
+    // Пять произведений независимы
+    if (parallelism(an + bn) > 1) {
+        ThreadPool::parallelFor(5, pointwise);
+    } else {
+        for (std::size_t i = 0; i < 5; ++i)
+            pointwise(i);
+    }
+    SignedLimbs &r0 = products[0], &r1 = products[1], &rm1 = products[2], &rm2 = products[3], &rInf = products[4];
+
+    // Интерполяция
+    SignedLimbs r3 = addSigned(rm2, r1, true);
+    divideExactBySmall(r3, 3);
+    r1 = addSigned(r1, rm1, true);
+    divideExactBySmall(r1, 2);
+    SignedLimbs r2 = addSigned(rm1, r0, true);
+    r3 = addSigned(r2, r3, true);
+    divideExactBySmall(r3, 2);
+    SignedLimbs twoInf = rInf;
+    multiplyBySmall(twoInf, 2);
+    r3 = addSigned(r3, twoInf, false);
+    r2 = addSigned(r2, r1, false);
+    r2 = addSigned(r2, rInf, true);
+    r1 = addSigned(r1, r3, true);
+
+    // Все коэффициенты произведения неотрицательны, собираем их со сдвигами
+    std::fill(r, r + an + bn, 0);
+    addAt(r, an + bn, 0, r0);
+    addAt(r, an + bn, k, r1);
+    addAt(r, an + bn, 2 * k, r2);
+    addAt(r, an + bn, 3 * k, r3);
+    addAt(r, an + bn, 4 * k, rInf);
+}
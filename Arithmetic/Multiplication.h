@@ -0,0 +1,55 @@
+#ifndef DMATGCOLLOQUIUM_MULTIPLICATION_H
+#define DMATGCOLLOQUIUM_MULTIPLICATION_H
+
+#include "LimbArithmetic.h"
+
+/**
+ * @brief Пороги переключения алгоритмов умножения, в словах меньшего множителя.
+ */
+struct MultiplicationThresholds {
+    std::size_t karatsuba = 24; /**< начиная с этой длины используется алгоритм Карацубы */
+    std::size_t toom3 = 192;    /**< начиная с этой длины используется Тоом-3 */
+    std::size_t ntt = 3072;     /**< начиная с этой длины используется умножение через NTT */
+    std::size_t karatsubaSquare = 48; /**< начиная с этой длины квадрат считается Карацубой */
+    std::size_t parallelChunk = 8192; /**< слов произведения на поток: NTT и Тоом-3 занимают не больше длина / parallelChunk потоков ThreadPool */
+};
+
+/**
+ * @brief Движок умножения массивов слов.
+ *
+ * По длине операндов выбирает умножение в столбик, алгоритм Карацубы, Тоом-Кука (Тоом-3)
+ * или умножение через теоретико-числовое преобразование для самых длинных чисел.
+ * Сильно несбалансированные множители режутся на куски длины меньшего, чтобы рекурсивные
+ * алгоритмы всегда работали с операндами сравнимой длины. Умножение массива на самого себя
+ * (тот же указатель и длина) распознаётся и идёт через возведение в квадрат.
+ * Если в ThreadPool больше одного потока, независимые части длинных произведений (свёртки NTT,
+ * поточечные произведения Тоом-3) считаются параллельно.
+ */
+class Multiplication {
+public:
+    /**
+     * @brief r[0..an+bn) = a * b при an >= bn > 0. Буфер r не должен пересекаться с a и b.
+     */
+    static void multiply(Limb* r, const Limb* a, std::size_t an, const Limb* b, std::size_t bn);
+
+    /**
+     * @brief r[0..2n) = a * a при n > 0. Буфер r не должен пересекаться с a.
+     *
+     * Квадрат в столбик, Карацуба и NTT требуют меньше умножений слов, чем произведение
+     * двух разных чисел: в столбик и в NTT примерно вдвое, в Карацубе - три рекурсивных квадрата.
+     */
+    static void square(Limb* r, const Limb* a, std::size_t n);
+
+    static MultiplicationThresholds getThresholds();
+    static void setThresholds(const MultiplicationThresholds& thresholds);
+
+private:
+    static void multiplyUnbalanced(Limb* r, const Limb* a, std::size_t an, const Limb* b, std::size_t bn);
+    static void karatsuba(Limb* r, const Limb* a, std::size_t an, const Limb* b, std::size_t bn);
+    static void toom3(Limb* r, const Limb* a, std::size_t an, const Limb* b, std::size_t bn);
+    static void karatsubaSquare(Limb* r, const Limb* a, std::size_t n);
+    static std::size_t parallelism(std::size_t resultSize);
+};
+
+
+#endif //DMATGCOLLOQUIUM_MULTIPLICATION_H
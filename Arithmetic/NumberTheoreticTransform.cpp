@@ -0,0 +1,290 @@
+#include "NumberTheoreticTransform.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+    // f(from, to) для частей [0, n), поделённого на tasks почти равных кусков
+    template<class Range>
+    void parallelRanges(std::size_t n, std::size_t tasks, const Range &f) {
+        if (tasks <= 1) {
+            f(std::size_t{0}, n);
+            return;
+        }
+        ThreadPool::parallelFor(tasks, [&](std::size_t t) { f(n * t / tasks, n * (t + 1) / tasks); });
+    }
+
+    // Поле вычетов по простому модулю p < 2^63, элементы хранятся в форме Монтгомери (x * 2^64 mod p)
+    struct PrimeField {
+        Limb p;
+        Limb negativeInverse; // -p^(-1) mod 2^64
+        Limb r2;              // 2^128 mod p
+        Limb one;             // 2^64 mod p, единица в форме Монтгомери
+        Limb generator;       // первообразный корень
+
+        PrimeField(Limb prime, Limb primitiveRoot) : p(prime), generator(primitiveRoot) {
+            Limb inverse = p; // p * p = 1 mod 8, каждая итерация Ньютона удваивает число верных бит
+            for (int i = 0; i < 5; ++i)
+                inverse *= 2 - p * inverse;
+            negativeInverse = 0 - inverse;
+            one = (0 - p) % p;
+            r2 = static_cast<Limb>(static_cast<DoubleLimb>(one) * one % p);
+        }
+
+        // t * 2^(-64) mod p при t < p * 2^64
+        Limb reduce(DoubleLimb t) const {
+            Limb m = static_cast<Limb>(t) * negativeInverse;
+            DoubleLimb u = t + static_cast<DoubleLimb>(m) * p;
+            Limb result = static_cast<Limb>(u >> LimbArithmetic::LIMB_BITS);
+            return result >= p ? result - p : result;
+        }
+
+        Limb mul(Limb a, Limb b) const { return reduce(static_cast<DoubleLimb>(a) * b); }
+        Limb add(Limb a, Limb b) const { Limb s = a + b; return s >= p ? s - p : s; }
+        Limb sub(Limb a, Limb b) const { return a >= b ? a - b : a + p - b; }
+        // Любое 64-битное число, в том числе больше p
+        Limb toMontgomery(Limb a) const { return mul(a, r2); }
+
+        Limb power(Limb base, Limb exponent) const {
+            Limb result = one;
+            while (exponent) {
+                if (exponent & 1)
+                    result = mul(result, base);
+                base = mul(base, base);
+                exponent >>= 1;
+            }
+            return result;
+        }
+
+        // roots[half + j] = w_(2*half)^j для всех half = 1, 2, ..., n/2 (форма Монтгомери)
+        std::vector<Limb> rootTable(std::size_t n, bool inverse) const {
+            Limb w = power(toMontgomery(generator), (p - 1) / n);
+            if (inverse)
+                w = power(w, p - 2);
+            std::vector<Limb> roots(n);
+            for (std::size_t half = n / 2; half >= 1; half /= 2) {
+                roots[half] = one;
+                for (std::size_t j = 1; j < half; ++j)
+                    roots[half + j] = mul(roots[half + j - 1], w);
+                w = mul(w, w);
+            }
+            return roots;
+        }
+
+        // Бабочки этапа half с номерами [from, to), бабочка t - пара (i + j, i + j + half), i = t / half * 2 * half.
+        // Здесь и ниже поле копируется в локальную переменную: иначе после каждой записи в a компилятор
+        // перечитывает p и -p^(-1) из памяти, ведь a может указывать на них
+        void forwardStage(Limb *a, std::size_t half, const Limb *roots, std::size_t from, std::size_t to) const {
+            const PrimeField field = *this;
+            std::size_t i = from / half * 2 * half, j = from % half;
+            for (std::size_t t = from; t < to; ++t) {
+                Limb u = a[i + j];
+                Limb v = a[i + j + half];
+                a[i + j] = field.add(u, v);
+                a[i + j + half] = field.mul(field.sub(u, v), roots[half + j]);
+                if (++j == half) {
+                    j = 0;
+                    i += 2 * half;
+                }
+            }
+        }
+
+        void inverseStage(Limb *a, std::size_t half, const Limb *roots, std::size_t from, std::size_t to) const {
+            const PrimeField field = *this;
+            std::size_t i = from / half * 2 * half, j = from % half;
+            for (std::size_t t = from; t < to; ++t) {
+                Limb u = a[i + j];
+                Limb v = field.mul(a[i + j + half], roots[half + j]);
+                a[i + j] = field.add(u, v);
+                a[i + j + half] = field.sub(u, v);
+                if (++j == half) {
+                    j = 0;
+                    i += 2 * half;
+                }
+            }
+        }
+
+        // После верхних этапов прямого преобразования массив распадается на независимые блоки:
+        // эти этапы делятся между потоками по бабочкам, а блоки преобразуются каждый в своём потоке
+        void forward(Limb *a, std::size_t n, const Limb *roots, std::size_t tasks) const {
+            std::size_t size = n, blocks = 1;
+            for (; blocks < tasks && size > 1; size /= 2, blocks *= 2)
+                parallelRanges(n / 2, tasks, [&](std::size_t from, std::size_t to) { forwardStage(a, size / 2, roots, from, to); });
+            ThreadPool::parallelFor(blocks, [&](std::size_t block) { forward(a + block * size, size, roots); });
+        }
+
+        // Обратное преобразование идёт в обратном порядке: сначала блоки, потом общие этапы
+        void inverse(Limb *a, std::size_t n, const Limb *roots, std::size_t tasks) const {
+            std::size_t size = n, blocks = 1;
+            for (; blocks < tasks && size > 1; size /= 2)
+                blocks *= 2;
+            ThreadPool::parallelFor(blocks, [&](std::size_t block) { inverse(a + block * size, size, roots); });
+            for (; size < n; size *= 2)
+                parallelRanges(n / 2, tasks, [&](std::size_t from, std::size_t to) { inverseStage(a, size, roots, from, to); });
+        }
+
+        // Прямое преобразование с прореживанием по частоте: естественный порядок на входе, бит-реверсный на выходе
+        void forward(Limb *a, std::size_t n, const Limb *roots) const {
+            const PrimeField field = *this;
+            for (std::size_t half = n / 2; half >= 1; half /= 2) {
+                for (std::size_t i = 0; i < n; i += 2 * half) {
+                    for (std::size_t j = 0; j < half; ++j) {
+                        Limb u = a[i + j];
+                        Limb v = a[i + j + half];
+                        a[i + j] = field.add(u, v);
+                        a[i + j + half] = field.mul(field.sub(u, v), roots[half + j]);
+                    }
+                }
+            }
+        }
+
+        // Обратное преобразование с прореживанием по времени: бит-реверсный порядок на входе, естественный на выходе
+        void inverse(Limb *a, std::size_t n, const Limb *roots) const {
+            const PrimeField field = *this;
+            for (std::size_t half = 1; half < n; half *= 2) {
+                for (std::size_t i = 0; i < n; i += 2 * half) {
+                    for (std::size_t j = 0; j < half; ++j) {
+                        Limb u = a[i + j];
+                        Limb v = field.mul(a[i + j + half], roots[half + j]);
+                        a[i + j] = field.add(u, v);
+                        a[i + j + half] = field.sub(u, v);
+                    }
+                }
+            }
+        }
+
+        // Циклическая свёртка по модулю p, результат - обычные (не Монтгомери) вычеты.
+        // Для квадрата (b == a) второе прямое преобразование не нужно. Работа делится на tasks потоков.
+        std::vector<Limb> convolve(const Limb *a, std::size_t an, const Limb *b, std::size_t bn, std::size_t n,
+                                   std::size_t tasks) const {
+            const bool squaring = a == b && an == bn;
+            std::vector<Limb> fa(n, 0);
+            std::vector<Limb> fb(squaring ? 0 : n, 0);
+            const std::vector<Limb> roots = rootTable(n, false);
+            auto transform = [&](std::vector<Limb> &f, const Limb *x, std::size_t xn, std::size_t transformTasks) {
+                parallelRanges(xn, transformTasks, [&](std::size_t from, std::size_t to) {
+                    for (std::size_t i = from; i < to; ++i)
+                        f[i] = toMontgomery(x[i]);
+                });
+                forward(f.data(), n, roots.data(), transformTasks);
+            };
+            if (squaring) {
+                transform(fa, a, an, tasks);
+            } else if (tasks < 2) {
+                transform(fa, a, an, 1);
+                transform(fb, b, bn, 1);
+            } else {
+                // Преобразования двух множителей независимы
+                ThreadPool::parallelFor(2, [&](std::size_t k) {
+                    transform(k == 0 ? fa : fb, k == 0 ? a : b, k == 0 ? an : bn, (tasks + 1 - k) / 2);
+                });
+            }
+            parallelRanges(n, tasks, [&](std::size_t from, std::size_t to) {
+                const std::vector<Limb> &other = squaring ? fa : fb;
+                for (std::size_t i = from; i < to; ++i)
+                    fa[i] = mul(fa[i], other[i]);
+            });
+            inverse(fa.data(), n, rootTable(n, true).data(), tasks);
+
+            // Умножение на обычное n^(-1) одновременно делит на n и выводит из формы Монтгомери
+            const Limb nInverse = reduce(power(toMontgomery(n), p - 2));
+            parallelRanges(n, tasks, [&](std::size_t from, std::size_t to) {
+                for (std::size_t i = from; i < to; ++i)
+                    fa[i] = mul(fa[i], nInverse);
+            });
+            return fa;
+        }
+    };
+
+    const PrimeField FIELD_1(29ULL * (1ULL << 57) + 1, 3);
+    const PrimeField FIELD_2(69ULL * (1ULL << 55) + 1, 5);
+    const PrimeField FIELD_3(27ULL * (1ULL << 56) + 1, 5);
+}
+
+void NumberTheoreticTransform::multiply(Limb *r, const Limb *a, std::size_t an, const Limb *b, std::size_t bn,
+                                       std::size_t threads) {
+    const std::size_t resultSize = an + bn;
+    std::size_t n = 1;
+    while (n < resultSize - 1)
+        n *= 2;
+
+    // Свёртки по трём модулям независимы, потоки делятся между ними поровну
+    const PrimeField *fields[] = {&FIELD_1, &FIELD_2, &FIELD_3};
+    std::vector<Limb> residues[3];
+    const std::size_t tasksPerField = std::max<std::size_t>(threads / 3, 1);
+    auto convolveField = [&](std::size_t k) { residues[k] = fields[k]->convolve(a, an, b, bn, n, tasksPerField); };
+    if (threads > 1) {
+        ThreadPool::parallelFor(3, convolveField);
+    } else {
+        for (std::size_t k = 0; k < 3; ++k)
+            convolveField(k);
+    }
+    const std::vector<Limb> &residues1 = residues[0];
+    const std::vector<Limb> &residues2 = residues[1];
+    const std::vector<Limb> &residues3 = residues[2];
+
+    // Константы схемы Гарнера в форме Монтгомери, умножение на них даёт обычный вычет
+    const Limb p1 = FIELD_1.p, p2 = FIELD_2.p;
+    const Limb inverse12 = FIELD_2.power(FIELD_2.toMontgomery(p1), p2 - 2);
+    const Limb p1Mod3 = FIELD_3.toMontgomery(p1);
+    const Limb p1p2Mod3 = FIELD_3.mul(p1Mod3, FIELD_3.toMontgomery(p2));
+    const Limb inverse123 = FIELD_3.power(p1p2Mod3, FIELD_3.p - 2);
+    const DoubleLimb p1p2 = static_cast<DoubleLimb>(p1) * p2;
+    const auto p1p2Low = static_cast<Limb>(p1p2);
+    const auto p1p2High = static_cast<Limb>(p1p2 >> LimbArithmetic::LIMB_BITS);
+
+    // Куски результата собираются независимо, каждый со своим переносом до трёх слов;
+    // переносы между кусками добавляются потом по порядку
+    const std::size_t chunks = std::max<std::size_t>(std::min(threads, resultSize), 1);
+    std::vector<Limb> chunkCarries(3 * chunks);
+    ThreadPool::parallelFor(chunks, [&](std::size_t chunk) {
+        const std::size_t from = resultSize * chunk / chunks, to = resultSize * (chunk + 1) / chunks;
+        Limb carry0 = 0, carry1 = 0, carry2 = 0;
+        for (std::size_t i = from; i < to; ++i) {
+            Limb x0 = 0, x1 = 0, x2 = 0;
+            if (i < resultSize - 1) {
+                // x = v1 + p1 * v2 + p1 * p2 * v3, где v1 < p1, v2 < p2, v3 < p3
+                const Limb v1 = residues1[i];
+                const Limb v2 = FIELD_2.mul(FIELD_2.sub(residues2[i], FIELD_2.mul(v1, FIELD_2.one)), inverse12);
+                Limb t = FIELD_3.sub(residues3[i], FIELD_3.mul(v1, FIELD_3.one));
+                t = FIELD_3.sub(t, FIELD_3.mul(v2, p1Mod3));
+                const Limb v3 = FIELD_3.mul(t, inverse123);
+
+                DoubleLimb low = static_cast<DoubleLimb>(p1) * v2 + v1;
+                DoubleLimb productLow = static_cast<DoubleLimb>(p1p2Low) * v3;
+                DoubleLimb productHigh = static_cast<DoubleLimb>(p1p2High) * v3;
+                DoubleLimb sum = static_cast<DoubleLimb>(static_cast<Limb>(low)) + static_cast<Limb>(productLow);
+                x0 = static_cast<Limb>(sum);
+                sum = (sum >> LimbArithmetic::LIMB_BITS) + (low >> LimbArithmetic::LIMB_BITS)
+                      + (productLow >> LimbArithmetic::LIMB_BITS) + static_cast<Limb>(productHigh);
+                x1 = static_cast<Limb>(sum);
+                x2 = static_cast<Limb>(sum >> LimbArithmetic::LIMB_BITS) + static_cast<Limb>(productHigh >> LimbArithmetic::LIMB_BITS);
+            }
+
+            DoubleLimb sum = static_cast<DoubleLimb>(x0) + carry0;
+            r[i] = static_cast<Limb>(sum);
+            sum = (sum >> LimbArithmetic::LIMB_BITS) + x1 + carry1;
+            carry0 = static_cast<Limb>(sum);
+            sum = (sum >> LimbArithmetic::LIMB_BITS) + x2 + carry2;
+            carry1 = static_cast<Limb>(sum);
+            carry2 = static_cast<Limb>(sum >> LimbArithmetic::LIMB_BITS);
+        }
+        chunkCarries[3 * chunk] = carry0;
+        chunkCarries[3 * chunk + 1] = carry1;
+        chunkCarries[3 * chunk + 2] = carry2;
+    });
+
+    // Произведение помещается в resultSize слов, поэтому перенос последнего куска нулевой
+    for (std::size_t chunk = 0; chunk + 1 < chunks; ++chunk) {
+        Limb carry = 0;
+        for (std::size_t i = resultSize * (chunk + 1) / chunks, k = 0; i < resultSize && (k < 3 || carry); ++i, ++k) {
+            DoubleLimb sum = static_cast<DoubleLimb>(r[i]) + carry + (k < 3 ? chunkCarries[3 * chunk + k] : 0);
+            r[i] = static_cast<Limb>(sum);
+            carry = static_cast<Limb>(sum >> LimbArithmetic::LIMB_BITS);
+        }
+    }
+}
+
+void NumberTheoreticTransform::square(Limb *r, const Limb *a, std::size_t n, std::size_t threads) {
+    multiply(r, a, n, a, n, threads);
+}
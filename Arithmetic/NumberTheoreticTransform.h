@@ -0,0 +1,32 @@
+#ifndef DMATGCOLLOQUIUM_NUMBERTHEORETICTRANSFORM_H
+#define DMATGCOLLOQUIUM_NUMBERTHEORETICTRANSFORM_H
+
+#include "LimbArithmetic.h"
+
+/**
+ * @brief Умножение очень длинных чисел через теоретико-числовое преобразование (NTT).
+ *
+ * Слова операндов без разбиения считаются коэффициентами многочленов, свёртка вычисляется
+ * по трём простым модулям вида c * 2^k + 1 (около 2^62), а коэффициенты восстанавливаются
+ * по китайской теореме об остатках (схема Гарнера). Произведение модулей больше 2^183,
+ * поэтому коэффициент свёртки (меньше bn * 2^128) восстанавливается точно при bn < 2^55.
+ *
+ * При threads > 1 работа делится между потоками ThreadPool: свёртки по трём модулям независимы,
+ * внутри свёртки - преобразования двух множителей, блоки бабочек и поэлементные проходы,
+ * а восстановление по Гарнеру идёт кусками с последующим сложением переносов между ними.
+ */
+class NumberTheoreticTransform {
+public:
+    /**
+     * @brief r[0..an+bn) = a * b при an >= bn > 0. Буфер r не должен пересекаться с a и b.
+     */
+    static void multiply(Limb* r, const Limb* a, std::size_t an, const Limb* b, std::size_t bn, std::size_t threads = 1);
+
+    /**
+     * @brief r[0..2n) = a * a, n > 0: одно прямое преобразование вместо двух. Буфер r не должен пересекаться с a.
+     */
+    static void square(Limb* r, const Limb* a, std::size_t n, std::size_t threads = 1);
+};
+
+
+#endif //DMATGCOLLOQUIUM_NUMBERTHEORETICTRANSFORM_H
@@ -0,0 +1,106 @@
+#include "ProductTree.h"
+#include "LimbVector.h"
+#include "GreatestCommonDivisor.h"
+#include "Multiplication.h"
+#include "ThreadPool.h"
+
+namespace {
+    std::size_t totalSize(const std::vector<std::vector<Limb>> &values, std::size_t from, std::size_t to) {
+        std::size_t result = 0;
+        for (std::size_t i = from; i < to; ++i)
+            result += values[i].size();
+        return result;
+    }
+
+    // f(i) для i из [0, count): в потоках пула, если parallel
+    template<class Task>
+    void forEach(std::size_t count, bool parallel, const Task &f) {
+        if (parallel) {
+            ThreadPool::parallelFor(count, f);
+        } else {
+            for (std::size_t i = 0; i < count; ++i)
+                f(i);
+        }
+    }
+}
+
+// Потоки окупаются с той же длины, что и в движке умножения
+bool ProductTree::isParallel(std::size_t limbs) {
+    return ThreadPool::getThreadCount() > 1 && limbs >= Multiplication::getThresholds().parallelChunk;
+}
+
+std::vector<Limb> ProductTree::productRange(const std::vector<std::vector<Limb>> &values, std::size_t from, std::size_t to) {
+    if (to - from == 1)
+        return values[from];
+    const std::size_t middle = from + (to - from) / 2;
+    std::vector<Limb> halves[2];
+    forEach(2, isParallel(totalSize(values, from, to)), [&](std::size_t k) {
+        halves[k] = k == 0 ? productRange(values, from, middle) : productRange(values, middle, to);
+    });
+    return LimbVector::multiply(halves[0], halves[1]);
+}
+
+std::vector<Limb> ProductTree::product(const std::vector<std::vector<Limb>> &values) {
+    if (values.empty())
+        return {1};
+    return productRange(values, 0, values.size());
+}
+
+std::vector<Limb> ProductTree::lcmRange(const std::vector<std::vector<Limb>> &values, std::size_t from, std::size_t to) {
+    if (to - from == 1)
+        return values[from];
+    const std::size_t middle = from + (to - from) / 2;
+    std::vector<Limb> halves[2];
+    forEach(2, isParallel(totalSize(values, from, to)), [&](std::size_t k) {
+        halves[k] = k == 0 ? lcmRange(values, from, middle) : lcmRange(values, middle, to);
+    });
+    // lcm(x, y) = x / gcd(x, y) * y, деление точное
+    std::vector<Limb> quotient;
+    LimbVector::divideRemainder(halves[0], GreatestCommonDivisor::gcd(halves[0], halves[1]), &quotient, nullptr);
+    return LimbVector::multiply(quotient, halves[1]);
+}
+
+std::vector<Limb> ProductTree::lcm(const std::vector<std::vector<Limb>> &values) {
+    if (values.empty())
+        return {1};
+    return lcmRange(values, 0, values.size());
+}
+
+std::vector<std::vector<std::vector<Limb>>> ProductTree::build(const std::vector<std::vector<Limb>> &values) {
+    std::vector<std::vector<std::vector<Limb>>> levels{values};
+    while (levels.back().size() > 1) {
+        const std::vector<std::vector<Limb>> &below = levels.back();
+        std::vector<std::vector<Limb>> level((below.size() + 1) / 2);
+        // Непарное последнее число переходит на уровень выше без изменений
+        forEach(level.size(), isParallel(totalSize(below, 0, below.size())), [&](std::size_t i) {
+            level[i] = 2 * i + 1 < below.size() ? LimbVector::multiply(below[2 * i], below[2 * i + 1]) : below[2 * i];
+        });
+        levels.push_back(std::move(level));
+    }
+    return levels;
+}
+
+std::vector<std::vector<Limb>> ProductTree::remainders(const std::vector<Limb> &x, const std::vector<std::vector<Limb>> &moduli) {
+    if (moduli.empty())
+        return {};
+    const std::vector<std::vector<std::vector<Limb>>> levels = build(moduli);
+
+    // Остаток от узла дерева - остаток от его родителя по модулю узла
+    auto reduce = [](const std::vector<Limb> &value, const std::vector<Limb> &modulus) {
+        if (LimbVector::compare(value, modulus) < 0)
+            return value;
+        std::vector<Limb> rest;
+        LimbVector::divideRemainder(value, modulus, nullptr, &rest);
+        return rest;
+    };
+    std::vector<std::vector<Limb>> current{reduce(x, levels.back()[0])};
+    for (std::size_t level = levels.size() - 1; level-- > 0;) {
+        const std::vector<std::vector<Limb>> &nodes = levels[level];
+        std::vector<std::vector<Limb>> next(nodes.size());
+        forEach(nodes.size(), isParallel(totalSize(nodes, 0, nodes.size())), [&](std::size_t i) {
+            next[i] = reduce(current[i / 2], nodes[i]);
+        });
+        current = std::move(next);
+    }
+    return current;
+}
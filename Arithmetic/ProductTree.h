@@ -0,0 +1,43 @@
+#ifndef DMATGCOLLOQUIUM_PRODUCTTREE_H
+#define DMATGCOLLOQUIUM_PRODUCTTREE_H
+
+#include "LimbArithmetic.h"
+#include <vector>
+
+/**
+ * @brief Пакетные операции над многими числами через сбалансированное дерево произведений.
+ *
+ * Последовательная свёртка a1 * a2 * ... * an умножает растущий результат на короткий множитель,
+ * и быстрые алгоритмы умножения почти не работают. В дереве соседние значения перемножаются
+ * попарно, на каждом уровне множители сравнимой длины, а общая стоимость - O(M(N) log n)
+ * для N слов всех чисел. Две половины дерева независимы и при длинных числах считаются
+ * в разных потоках ThreadPool.
+ */
+class ProductTree {
+public:
+    /**
+     * @brief Произведение всех чисел (пустой набор - 1).
+     */
+    static std::vector<Limb> product(const std::vector<std::vector<Limb>>& values);
+
+    /**
+     * @brief НОК ненулевых чисел (пустой набор - 1): lcm(x, y) = x * y / gcd(x, y) по тому же дереву.
+     */
+    static std::vector<Limb> lcm(const std::vector<std::vector<Limb>>& values);
+
+    /**
+     * @brief x mod m для каждого ненулевого модуля m: x делится на произведение модулей,
+     * остаток спускается по дереву произведений, и каждый модуль получает остаток от короткого числа.
+     */
+    static std::vector<std::vector<Limb>> remainders(const std::vector<Limb>& x, const std::vector<std::vector<Limb>>& moduli);
+
+private:
+    // Уровни дерева: levels[0] - сами числа, levels[k + 1][i] - произведение levels[k][2i] и levels[k][2i + 1]
+    static std::vector<std::vector<std::vector<Limb>>> build(const std::vector<std::vector<Limb>>& values);
+    static std::vector<Limb> productRange(const std::vector<std::vector<Limb>>& values, std::size_t from, std::size_t to);
+    static std::vector<Limb> lcmRange(const std::vector<std::vector<Limb>>& values, std::size_t from, std::size_t to);
+    static bool isParallel(std::size_t limbs);
+};
+
+
+#endif //DMATGCOLLOQUIUM_PRODUCTTREE_H
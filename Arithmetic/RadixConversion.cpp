@@ -0,0 +1,169 @@
+#include "RadixConversion.h"
+#include "LimbVector.h"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+namespace {
+    RadixThresholds currentThresholds;
+
+    // Кэш степеней P_k = 10^(19 * 2^k); deque не переносит элементы при росте, ссылки на них остаются верными
+    std::deque<std::vector<Limb>> powers;
+    std::mutex powersMutex;
+
+    // Число слов в P_k с запасом в одно слово: 19 * 2^k * log2(10) / 64
+    std::size_t estimatePowerLength(std::size_t k) {
+        return static_cast<std::size_t>(static_cast<double>(LimbArithmetic::DECIMAL_BASE_DIGITS) *
+                                        static_cast<double>(std::size_t{1} << k) * 3.32192809488736234787 /
+                                        LimbArithmetic::LIMB_BITS) + 1;
+    }
+}
+
+RadixThresholds RadixConversion::getThresholds() {
+    return currentThresholds;
+}
+
+void RadixConversion::setThresholds(const RadixThresholds &thresholds) {
+    // Печать делит число степенью длины около половины, на двух словах рекурсия должна остановиться
+    currentThresholds.divideAndConquer = std::max<std::size_t>(thresholds.divideAndConquer, 2);
+}
+
+const std::vector<Limb> &RadixConversion::power(std::size_t k) {
+    std::lock_guard<std::mutex> lock(powersMutex);
+    if (powers.empty())
+        powers.push_back({LimbArithmetic::DECIMAL_BASE});
+    while (powers.size() <= k)
+        powers.push_back(LimbVector::multiply(powers.back(), powers.back()));
+    return powers[k];
+}
+
+std::vector<Limb> RadixConversion::fromDecimal(const char *digits, std::size_t n) {
+    std::vector<Limb> result;
+    parse(result, digits, n);
+    return result;
+}
+
+void RadixConversion::parse(std::vector<Limb> &result, const char *digits, std::size_t n) {
+    if (n <= currentThresholds.divideAndConquer * LimbArithmetic::DECIMAL_BASE_DIGITS) {
+        parseBasecase(result, digits, n);
+        return;
+    }
+    // Младшая часть - наибольший блок из 19 * 2^k цифр, короче всей записи: он не меньше её половины
+    std::size_t k = 0;
+    while ((LimbArithmetic::DECIMAL_BASE_DIGITS << (k + 1)) < n)
+        ++k;
+    const std::size_t lowDigits = LimbArithmetic::DECIMAL_BASE_DIGITS << k;
+
+    std::vector<Limb> high;
+    std::vector<Limb> low;
+    parse(high, digits, n - lowDigits);
+    parse(low, digits + (n - lowDigits), lowDigits);
+    result = LimbVector::multiply(high, power(k));
+    LimbVector::addInPlace(result, low);
+}
+
+void RadixConversion::parseBasecase(std::vector<Limb> &result, const char *digits, std::size_t n) {
+    result.clear();
+    result.reserve(n / LimbArithmetic::DECIMAL_BASE_DIGITS + 1);
+
+    // Читаем запись блоками по 19 цифр, первый блок - остаток от деления длины на 19
+    std::size_t chunkSize = n % LimbArithmetic::DECIMAL_BASE_DIGITS;
+    if (chunkSize == 0)
+        chunkSize = LimbArithmetic::DECIMAL_BASE_DIGITS;
+    for (std::size_t pos = 0; pos < n; pos += chunkSize, chunkSize = LimbArithmetic::DECIMAL_BASE_DIGITS) {
+        Limb chunk = 0;
+        Limb chunkBase = 1;
+        for (std::size_t i = pos; i < pos + chunkSize; ++i) {
+            chunk = chunk * 10 + static_cast<Limb>(digits[i] - '0');
+            chunkBase *= 10;
+        }
+        // result = result * 10^chunkSize + chunk
+        Limb carry = LimbArithmetic::mul1(result.data(), result.data(), result.size(), chunkBase);
+        if (carry)
+            result.push_back(carry);
+        carry = LimbArithmetic::add1(result.data(), result.data(), result.size(), chunk);
+        if (carry)
+            result.push_back(carry);
+    }
+    LimbVector::trim(result);
+}
+
+std::string RadixConversion::toDecimal(const Limb *a, std::size_t n) {
+    n = LimbArithmetic::normalizedSize(a, n);
+    if (n == 0)
+        return "0";
+    std::string result;
+    result.reserve(static_cast<std::size_t>(static_cast<double>(n) * LimbArithmetic::LIMB_BITS * 0.30102999566398119521) + 1);
+    print(result, std::vector<Limb>(a, a + n));
+    return result;
+}
+
+void RadixConversion::print(std::string &out, const std::vector<Limb> &x) {
+    if (x.size() < currentThresholds.divideAndConquer) {
+        // Делим на 10^19, пока число не обнулится: каждый остаток - очередные 19 десятичных цифр
+        std::vector<Limb> rest(x);
+        std::vector<Limb> chunks;
+        chunks.reserve(rest.size() * 2);
+        while (!rest.empty())
+            chunks.push_back(takeDecimalChunk(rest));
+
+        out += std::to_string(chunks.back());
+        for (std::size_t i = chunks.size() - 1; i-- > 0;) {
+            out.append(LimbArithmetic::DECIMAL_BASE_DIGITS, '0');
+            writeChunk(&out[out.size() - LimbArithmetic::DECIMAL_BASE_DIGITS], LimbArithmetic::DECIMAL_BASE_DIGITS,
+                       chunks[i]);
+        }
+        return;
+    }
+    // Делитель P_k длиной около половины x: P_k < x, поэтому старшая часть ненулевая
+    std::size_t k = 0;
+    while (2 * estimatePowerLength(k + 1) <= x.size())
+        ++k;
+    std::vector<Limb> high;
+    std::vector<Limb> low;
+    LimbVector::divideRemainder(x, power(k), &high, &low);
+
+    print(out, high);
+    const std::size_t lowDigits = LimbArithmetic::DECIMAL_BASE_DIGITS << k;
+    out.append(lowDigits, '0');
+    printPadded(&out[out.size() - lowDigits], lowDigits, low);
+}
+
+void RadixConversion::printPadded(char *window, std::size_t width, const std::vector<Limb> &x) {
+    if (x.size() < currentThresholds.divideAndConquer) {
+        // Заполняем окно блоками по 19 цифр справа налево, оставшиеся слева позиции - ведущие нули
+        std::vector<Limb> rest(x);
+        while (!rest.empty()) {
+            const std::size_t chunkWidth = std::min<std::size_t>(width, LimbArithmetic::DECIMAL_BASE_DIGITS);
+            writeChunk(window + (width - chunkWidth), chunkWidth, takeDecimalChunk(rest));
+            width -= chunkWidth;
+        }
+        std::fill(window, window + width, '0');
+        return;
+    }
+    // Младшая часть - наибольший блок из 19 * 2^k цифр, короче окна
+    std::size_t k = 0;
+    while ((LimbArithmetic::DECIMAL_BASE_DIGITS << (k + 1)) < width)
+        ++k;
+    const std::size_t lowDigits = LimbArithmetic::DECIMAL_BASE_DIGITS << k;
+
+    std::vector<Limb> high;
+    std::vector<Limb> low;
+    LimbVector::divideRemainder(x, power(k), &high, &low);
+    printPadded(window, width - lowDigits, high);
+    printPadded(window + (width - lowDigits), lowDigits, low);
+}
+
+Limb RadixConversion::takeDecimalChunk(std::vector<Limb> &x) {
+    Limb chunk = LimbArithmetic::divRem1(x.data(), x.data(), x.size(), LimbArithmetic::DECIMAL_BASE);
+    LimbVector::trim(x);
+    return chunk;
+}
+
+// Пишет младшие width цифр chunk в window[0..width) с ведущими нулями
+void RadixConversion::writeChunk(char *window, std::size_t width, Limb chunk) {
+    for (std::size_t i = width; i-- > 0;) {
+        window[i] = static_cast<char>('0' + chunk % 10);
+        chunk /= 10;
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef DMATGCOLLOQUIUM_RADIXCONVERSION_H
+#define DMATGCOLLOQUIUM_RADIXCONVERSION_H
+
+#include "LimbArithmetic.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Пороги переключения алгоритмов перевода между основаниями, в словах.
+ */
+struct RadixThresholds {
+    std::size_t divideAndConquer = 24; /**< начиная с этой длины число делится пополам степенью 10^19 */
+};
+
+/**
+ * @brief Перевод массивов слов в десятичную запись и обратно.
+ *
+ * Короткие числа переводятся блоками по 19 цифр за квадратичное время. Длинные делятся пополам
+ * степенью P_k = 10^(19 * 2^k): при разборе x = старшая часть * P_k + младшая часть, при печати
+ * x делится на P_k с остатком, и обе половины переводятся рекурсивно. Степени P_k считаются
+ * последовательным возведением в квадрат один раз и хранятся в кэше, поэтому перевод стоит
+ * O(M(n) log n), где M(n) - стоимость умножения (деления) чисел длины n.
+ */
+class RadixConversion {
+public:
+    /**
+     * @brief Число по десятичной записи digits[0..n) от старшей цифры к младшей, n > 0, без старших нулевых слов.
+     */
+    static std::vector<Limb> fromDecimal(const char* digits, std::size_t n);
+
+    /**
+     * @brief Десятичная запись числа a[0..n) без ведущих нулей, для нуля - "0".
+     */
+    static std::string toDecimal(const Limb* a, std::size_t n);
+
+    static RadixThresholds getThresholds();
+    static void setThresholds(const RadixThresholds& thresholds);
+
+private:
+    /**
+     * @brief P_k = 10^(19 * 2^k) из кэша, при необходимости кэш достраивается.
+     */
+    static const std::vector<Limb>& power(std::size_t k);
+
+    static void parse(std::vector<Limb>& result, const char* digits, std::size_t n);
+    static void parseBasecase(std::vector<Limb>& result, const char* digits, std::size_t n);
+
+    /**
+     * @brief Дописывает в конец out десятичную запись ненулевого x без ведущих нулей.
+     */
+    static void print(std::string& out, const std::vector<Limb>& x);
+
+    /**
+     * @brief Пишет x в window[0..width) с ведущими нулями, x < 10^width.
+     */
+    static void printPadded(char* window, std::size_t width, const std::vector<Limb>& x);
+
+    /**
+     * @brief Отщепляет 19 младших цифр: x = x / 10^19, возвращает остаток.
+     */
+    static Limb takeDecimalChunk(std::vector<Limb>& x);
+    static void writeChunk(char* window, std::size_t width, Limb chunk);
+};
+
+
+#endif //DMATGCOLLOQUIUM_RADIXCONVERSION_H
@@ -0,0 +1,130 @@
+#include "Roots.h"
+#include "LimbVector.h"
+#include "Exponentiation.h"
+#include <cmath>
+
+namespace {
+    // Начиная с этой длины корня (в битах) приближение берётся из корня старшей половины числа
+    constexpr std::size_t RECURSIVE_SEED_BITS = 512;
+
+    std::vector<Limb> shiftRightBits(const std::vector<Limb> &x, std::size_t shift) {
+        std::vector<Limb> result = LimbVector::shiftRightLimbs(x, shift / LimbArithmetic::LIMB_BITS);
+        const unsigned bitShift = shift % LimbArithmetic::LIMB_BITS;
+        if (bitShift != 0 && !result.empty())
+            LimbArithmetic::shiftRight(result.data(), result.data(), result.size(), bitShift);
+        LimbVector::trim(result);
+        return result;
+    }
+
+    std::vector<Limb> shiftLeftBits(const std::vector<Limb> &x, std::size_t shift) {
+        std::vector<Limb> result(shift / LimbArithmetic::LIMB_BITS, 0);
+        result.insert(result.end(), x.begin(), x.end());
+        const unsigned bitShift = shift % LimbArithmetic::LIMB_BITS;
+        if (bitShift != 0) {
+            result.push_back(0);
+            const std::size_t low = shift / LimbArithmetic::LIMB_BITS;
+            LimbArithmetic::shiftLeft(result.data() + low, result.data() + low, result.size() - low, bitShift);
+        }
+        LimbVector::trim(result);
+        return result;
+    }
+}
+
+std::size_t Roots::bitLength(const std::vector<Limb> &x) {
+    if (x.empty())
+        return 0;
+    return x.size() * LimbArithmetic::LIMB_BITS - LimbArithmetic::countLeadingZeros(x.back());
+}
+
+std::vector<Limb> Roots::initialApproximation(const std::vector<Limb> &x, std::size_t k) {
+    // x ~ t * 2^s, где t - 64 старших бита
+    const std::size_t bits = bitLength(x);
+    const std::size_t s = bits > LimbArithmetic::LIMB_BITS ? bits - LimbArithmetic::LIMB_BITS : 0;
+    Limb t = x[s / LimbArithmetic::LIMB_BITS] >> (s % LimbArithmetic::LIMB_BITS);
+    if (s % LimbArithmetic::LIMB_BITS != 0 && s / LimbArithmetic::LIMB_BITS + 1 < x.size())
+        t |= x[s / LimbArithmetic::LIMB_BITS + 1] << (LimbArithmetic::LIMB_BITS - s % LimbArithmetic::LIMB_BITS);
+
+    // x^(1/k) ~ 2^((log2 t + s mod k) / k) * 2^(s div k), первый множитель меньше 2^33.
+    // Запас 2^(-40) с лихвой перекрывает ошибки двойной точности, и приближение не меньше корня.
+    const std::size_t q = s / k;
+    const double f = (std::log2(static_cast<double>(t)) + static_cast<double>(s % k)) / static_cast<double>(k);
+    const unsigned fractionBits = 20;
+    const auto scaled = static_cast<Limb>(std::ceil(std::ldexp(std::exp2(f) * (1 + std::ldexp(1.0, -40)),
+                                                                static_cast<int>(fractionBits)))) + 1;
+    if (q < fractionBits)
+        return {(scaled >> (fractionBits - q)) + 1};
+
+    // scaled * 2^(q - 20)
+    const std::size_t shift = q - fractionBits;
+    std::vector<Limb> result(shift / LimbArithmetic::LIMB_BITS, 0);
+    const unsigned bitShift = shift % LimbArithmetic::LIMB_BITS;
+    result.push_back(scaled << bitShift);
+    if (bitShift != 0)
+        result.push_back(scaled >> (LimbArithmetic::LIMB_BITS - bitShift));
+    LimbVector::trim(result);
+    return result;
+}
+
+std::vector<Limb> Roots::root(const std::vector<Limb> &x, std::size_t k) {
+    if (x.empty() || k == 1)
+        return x;
+    // x < 2^bits <= 2^k, значит корень меньше двух
+    if (k >= bitLength(x))
+        return {1};
+
+    const Limb powerOfY = k - 1;
+    std::vector<Limb> y;
+    const std::size_t rootBits = bitLength(x) / k;
+    if (rootBits >= RECURSIVE_SEED_BITS) {
+        // x < (x' + 1) * 2^(k*m) для x' = x >> (k*m), поэтому (root(x') + 1) * 2^m не меньше корня
+        // и верен примерно в половине бит: до ответа остаётся одна-две итерации на полной длине
+        const std::size_t m = rootBits / 2;
+        y = root(shiftRightBits(x, k * m), k);
+        LimbVector::increment(y);
+        y = shiftLeftBits(y, m);
+    } else {
+        y = initialApproximation(x, k);
+    }
+    while (true) {
+        // z = ((k - 1) * y + x / y^(k-1)) / k
+        std::vector<Limb> z;
+        LimbVector::divideRemainder(x, Exponentiation::power(y, &powerOfY, 1), &z, nullptr);
+        std::vector<Limb> scaledY = y;
+        Limb carry = LimbArithmetic::mul1(scaledY.data(), scaledY.data(), scaledY.size(), k - 1);
+        if (carry)
+            scaledY.push_back(carry);
+        LimbVector::addInPlace(z, scaledY);
+        LimbArithmetic::divRem1(z.data(), z.data(), z.size(), k);
+        LimbVector::trim(z);
+
+        // Сверху итерация строго убывает, пока не дойдёт до floor(x^(1/k))
+        if (LimbVector::compare(z, y) >= 0)
+            return y;
+        y = std::move(z);
+    }
+}
+
+bool Roots::isPerfectPower(const std::vector<Limb> &x) {
+    if (x.empty() || (x.size() == 1 && x[0] == 1))
+        return true;
+    const std::size_t bits = bitLength(x);
+
+    // Если x = y^p, то число младших нулевых бит x делится на p
+    std::size_t trailingZeros = 0;
+    while (x[trailingZeros / LimbArithmetic::LIMB_BITS] == 0)
+        trailingZeros += LimbArithmetic::LIMB_BITS;
+    trailingZeros += LimbArithmetic::countTrailingZeros(x[trailingZeros / LimbArithmetic::LIMB_BITS]);
+
+    // Достаточно простых показателей p: y^(ab) = (y^a)^b. При y >= 2 показатель меньше битовой длины x
+    for (Limb p = 2; p < bits; ++p) {
+        bool isPrime = true;
+        for (Limb d = 2; d * d <= p && isPrime; ++d)
+            isPrime = p % d != 0;
+        if (!isPrime || (trailingZeros != 0 && trailingZeros % p != 0))
+            continue;
+        const std::vector<Limb> y = root(x, p);
+        if (LimbVector::compare(Exponentiation::power(y, &p, 1), x) == 0)
+            return true;
+    }
+    return false;
+}
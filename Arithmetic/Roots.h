@@ -0,0 +1,38 @@
+#ifndef DMATGCOLLOQUIUM_ROOTS_H
+#define DMATGCOLLOQUIUM_ROOTS_H
+
+#include "LimbArithmetic.h"
+#include <vector>
+
+/**
+ * @brief Целые корни массивов слов итерациями Ньютона.
+ *
+ * Целочисленная итерация y = ((k - 1) * y + x / y^(k-1)) / k, начатая не ниже корня, монотонно
+ * убывает к floor(x^(1/k)) и удваивает число верных бит на каждом шаге. Для коротких корней
+ * начальное приближение строится по 64 старшим битам числа в двойной точности с небольшим запасом
+ * вверх (около 50 верных бит). Для длинных - рекурсивно, по корню из старшей половины числа:
+ * в нём верна половина бит, и на полной длине остаются одна-две итерации, так что корень
+ * стоит O(M(n)) с точностью до постоянного множителя.
+ */
+class Roots {
+public:
+    /**
+     * @brief floor(x^(1/k)) для нормализованного x и k > 0.
+     */
+    static std::vector<Limb> root(const std::vector<Limb>& x, std::size_t k);
+
+    /**
+     * @brief Представимо ли x в виде y^k при k >= 2 (0 и 1 представимы).
+     */
+    static bool isPerfectPower(const std::vector<Limb>& x);
+
+private:
+    /**
+     * @brief Приближение корня не меньше floor(x^(1/k)), x > 1, k < битовой длины x.
+     */
+    static std::vector<Limb> initialApproximation(const std::vector<Limb>& x, std::size_t k);
+    static std::size_t bitLength(const std::vector<Limb>& x);
+};
+
+
+#endif //DMATGCOLLOQUIUM_ROOTS_H
@@ -0,0 +1,119 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Одна раздача задач parallelFor, живёт на стеке вызывающего потока
+    struct Job {
+        const std::function<void(std::size_t)> *task;
+        std::size_t count;
+        std::size_t next = 0; // первая невзятая задача
+        std::size_t done = 0;
+        std::exception_ptr error;
+        std::condition_variable finished;
+    };
+
+    struct Pool {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<Job *> jobs; // раздачи, в которых остались невзятые задачи
+        std::vector<std::thread> workers;
+        bool stopping = false;
+
+        ~Pool() {
+            stop();
+        }
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (std::thread &worker : workers)
+                worker.join();
+            workers.clear();
+            stopping = false;
+        }
+
+        // Берёт очередную задачу раздачи, вызывается под mutex
+        std::size_t claim(Job &job) {
+            const std::size_t index = job.next++;
+            if (job.next == job.count)
+                jobs.erase(std::find(jobs.begin(), jobs.end(), &job));
+            return index;
+        }
+
+        // Выполняет задачу без блокировки и отмечает её под mutex, lock должен быть захвачен
+        void run(Job &job, std::size_t index, std::unique_lock<std::mutex> &lock) {
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                (*job.task)(index);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (error && !job.error)
+                job.error = error;
+            if (++job.done == job.count)
+                job.finished.notify_all();
+        }
+
+        void work() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (stopping)
+                    return;
+                Job &job = *jobs.front();
+                run(job, claim(job), lock);
+            }
+        }
+    };
+
+    Pool &pool() {
+        static Pool instance;
+        return instance;
+    }
+}
+
+std::size_t ThreadPool::getThreadCount() {
+    return pool().workers.size() + 1;
+}
+
+void ThreadPool::setThreadCount(std::size_t count) {
+    if (count == 0)
+        count = std::max(std::thread::hardware_concurrency(), 1U);
+    Pool &instance = pool();
+    instance.stop();
+    for (std::size_t i = 1; i < count; ++i)
+        instance.workers.emplace_back([&instance] { instance.work(); });
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)> &task) {
+    Pool &instance = pool();
+    if (instance.workers.empty() || count <= 1) {
+        for (std::size_t i = 0; i < count; ++i)
+            task(i);
+        return;
+    }
+
+    Job job;
+    job.task = &task;
+    job.count = count;
+    std::unique_lock<std::mutex> lock(instance.mutex);
+    instance.jobs.push_back(&job);
+    instance.wake.notify_all();
+    // Вызывающий поток работает наравне с пулом, а ждёт только уже взятые другими задачи
+    while (job.next < job.count)
+        instance.run(job, instance.claim(job), lock);
+    job.finished.wait(lock, [&job] { return job.done == job.count; });
+    if (job.error)
+        std::rethrow_exception(job.error);
+}
@@ -0,0 +1,32 @@
+#ifndef DMATGCOLLOQUIUM_THREADPOOL_H
+#define DMATGCOLLOQUIUM_THREADPOOL_H
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * @brief Общий пул потоков для независимых частей длинных вычислений (см. Multiplication).
+ *
+ * По умолчанию в пуле один поток - вызывающий, и parallelFor выполняет задачи по очереди.
+ * setThreadCount(n) запускает n - 1 рабочих потоков. Вызывающий поток сам берёт задачи наравне
+ * с рабочими, поэтому parallelFor можно вызывать и из задачи: ожидание не занимает поток, пока
+ * есть невзятые задачи.
+ */
+class ThreadPool {
+public:
+    static std::size_t getThreadCount();
+
+    /**
+     * @brief Задаёт число потоков, 0 - по числу ядер. Нельзя вызывать во время вычислений в пуле.
+     */
+    static void setThreadCount(std::size_t count);
+
+    /**
+     * @brief Выполняет task(0), ..., task(count - 1) в потоках пула и ждёт их завершения.
+     * Первое исключение из задач пробрасывается вызывающему после завершения остальных.
+     */
+    static void parallelFor(std::size_t count, const std::function<void(std::size_t)>& task);
+};
+
+
+#endif //DMATGCOLLOQUIUM_THREADPOOL_H
@@ -0,0 +1,123 @@
+#include "VectorKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DMATGCOLLOQUIUM_HAS_X86_KERNELS 1
+#endif
+
+#ifdef DMATGCOLLOQUIUM_HAS_X86_KERNELS
+
+namespace {
+    // Маска переносов, пришедших в каждое из восьми слов: перенос, порождённый словом j (или входной),
+    // бежит через подряд идущие пропускающие слова, что в точности повторяет целочисленное сложение.
+    // Порождающие и пропускающие слова не совпадают, поэтому сумма не теряет битов.
+    inline unsigned incomingCarries(unsigned generate, unsigned propagate, Limb carry, Limb &carryOut) {
+        unsigned injected = (generate << 1) | static_cast<unsigned>(carry);
+        unsigned sum = propagate + injected;
+        carryOut = (sum >> 8) & 1;
+        return sum ^ propagate;
+    }
+
+    // Слова, в которые пришёл перенос, получают -1 (все биты), остальные - 0
+    __attribute__((target("avx2"))) inline __m256i laneMask(unsigned bits) {
+        const __m256i select = _mm256_set_epi64x(8, 4, 2, 1);
+        __m256i spread = _mm256_and_si256(_mm256_set1_epi64x(bits), select);
+        return _mm256_cmpeq_epi64(spread, select);
+    }
+
+    __attribute__((target("avx2"))) inline unsigned laneBits(__m256i x) {
+        return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(x)));
+    }
+}
+
+bool VectorKernels::hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+__attribute__((target("avx2")))
+Limb VectorKernels::addNAvx2(Limb *r, const Limb *a, const Limb *b, std::size_t n, Limb carry) {
+    // AVX2 сравнивает только знаковые 64-битные числа, беззнаковое сравнение - после сдвига на 2^63
+    const __m256i signBit = _mm256_set1_epi64x(static_cast<long long>(1ULL << 63));
+    const __m256i allOnes = _mm256_set1_epi64x(-1);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i xLow = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        __m256i xHigh = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i + 4));
+        __m256i sumLow = _mm256_add_epi64(xLow, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i)));
+        __m256i sumHigh = _mm256_add_epi64(xHigh, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i + 4)));
+        // Переполнение: sum < x как беззнаковые
+        unsigned generate = laneBits(_mm256_cmpgt_epi64(_mm256_xor_si256(xLow, signBit),
+                                                         _mm256_xor_si256(sumLow, signBit))) |
+                            laneBits(_mm256_cmpgt_epi64(_mm256_xor_si256(xHigh, signBit),
+                                                         _mm256_xor_si256(sumHigh, signBit))) << 4;
+        unsigned propagate = laneBits(_mm256_cmpeq_epi64(sumLow, allOnes)) |
+                             laneBits(_mm256_cmpeq_epi64(sumHigh, allOnes)) << 4;
+        unsigned incoming = incomingCarries(generate, propagate, carry, carry);
+        // Вычитание маски из -1 прибавляет единицу в слова с пришедшим переносом
+        sumLow = _mm256_sub_epi64(sumLow, laneMask(incoming & 0xF));
+        sumHigh = _mm256_sub_epi64(sumHigh, laneMask(incoming >> 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + i), sumLow);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + i + 4), sumHigh);
+    }
+    for (; i < n; ++i) {
+        Limb s = a[i] + carry;
+        carry = s < carry;
+        r[i] = s + b[i];
+        carry += r[i] < s;
+    }
+    return carry;
+}
+
+__attribute__((target("avx2")))
+Limb VectorKernels::subNAvx2(Limb *r, const Limb *a, const Limb *b, std::size_t n, Limb borrow) {
+    const __m256i signBit = _mm256_set1_epi64x(static_cast<long long>(1ULL << 63));
+    const __m256i zero = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i xLow = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        __m256i xHigh = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i + 4));
+        __m256i yLow = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+        __m256i yHigh = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i + 4));
+        __m256i differenceLow = _mm256_sub_epi64(xLow, yLow);
+        __m256i differenceHigh = _mm256_sub_epi64(xHigh, yHigh);
+        // Заём: x < y как беззнаковые
+        unsigned generate = laneBits(_mm256_cmpgt_epi64(_mm256_xor_si256(yLow, signBit),
+                                                         _mm256_xor_si256(xLow, signBit))) |
+                            laneBits(_mm256_cmpgt_epi64(_mm256_xor_si256(yHigh, signBit),
+                                                         _mm256_xor_si256(xHigh, signBit))) << 4;
+        unsigned propagate = laneBits(_mm256_cmpeq_epi64(differenceLow, zero)) |
+                             laneBits(_mm256_cmpeq_epi64(differenceHigh, zero)) << 4;
+        unsigned incoming = incomingCarries(generate, propagate, borrow, borrow);
+        // Сложение с маской (-1) вычитает единицу из слов с пришедшим заёмом
+        differenceLow = _mm256_add_epi64(differenceLow, laneMask(incoming & 0xF));
+        differenceHigh = _mm256_add_epi64(differenceHigh, laneMask(incoming >> 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + i), differenceLow);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + i + 4), differenceHigh);
+    }
+    for (; i < n; ++i) {
+        Limb ai = a[i];
+        Limb d = ai - b[i];
+        Limb borrowOut = ai < b[i];
+        r[i] = d - borrow;
+        borrowOut |= d < borrow;
+        borrow = borrowOut;
+    }
+    return borrow;
+}
+
+#else
+
+bool VectorKernels::hasAvx2() {
+    return false;
+}
+
+Limb VectorKernels::addNAvx2(Limb *, const Limb *, const Limb *, std::size_t, Limb carry) {
+    return carry;
+}
+
+Limb VectorKernels::subNAvx2(Limb *, const Limb *, const Limb *, std::size_t, Limb borrow) {
+    return borrow;
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef DMATGCOLLOQUIUM_VECTORKERNELS_H
+#define DMATGCOLLOQUIUM_VECTORKERNELS_H
+
+#include "LimbArithmetic.h"
+
+/**
+ * @brief Векторные (AVX2) варианты сложения и вычитания массивов слов.
+ *
+ * Слова складываются по восемь (два регистра) без учёта переноса. Затем для каждой восьмёрки строятся
+ * две битовые маски: слова, породившие перенос (сумма переполнилась), и слова, которые его
+ * пропускают дальше (сумма равна 2^64 - 1). Переносы между словами находятся одним целочисленным
+ * сложением этих масок, как в сумматоре с ускоренным переносом, и добавляются вторым проходом.
+ * Вычитание устроено так же: заём порождает слово с a < b и пропускает слово с нулевой разностью.
+ *
+ * Ядра выбираются во время выполнения: если процессор не поддерживает AVX2, LimbArithmetic
+ * использует скалярный цикл.
+ */
+class VectorKernels {
+public:
+    /**
+     * @brief Поддерживает ли процессор AVX2, проверяется один раз.
+     */
+    static bool hasAvx2();
+
+    /**
+     * @brief r[0..n) = a + b + carry, возвращает перенос. Требует AVX2.
+     */
+    static Limb addNAvx2(Limb* r, const Limb* a, const Limb* b, std::size_t n, Limb carry);
+
+    /**
+     * @brief r[0..n) = a - b - borrow, возвращает заём. Требует AVX2.
+     */
+    static Limb subNAvx2(Limb* r, const Limb* a, const Limb* b, std::size_t n, Limb borrow);
+};
+
+
+#endif //DMATGCOLLOQUIUM_VECTORKERNELS_H
@@ -15,22 +15,22 @@ IntegerNumber::IntegerNumber(const std::string &s) {
         throw UniversalStringException("wrong argument, the string of numbers should not be empty");
     this->isNegativeFlag = s[0] == '-';
     if (isNegativeFlag)
-        this->number = new NaturalNumber(s.substr(1));
+        this->number = NaturalNumber(s.substr(1));
     else
-        this->number = new NaturalNumber(s);
+        this->number = NaturalNumber(s);
 }
 
 IntegerNumber::IntegerNumber(long long int a) {
     this->isNegativeFlag = a < 0;
-    this->number = new NaturalNumber(isNegativeFlag ? a*(-1) : a);
+    this->number = NaturalNumber(isNegativeFlag ? a*(-1) : a);
 }
 
 std::string IntegerNumber::toString() const {
-    return (isNegativeFlag ? "-" : "") + this->number->toString();
+    return (isNegativeFlag ? "-" : "") + this->number.toString();
 }
 
-const std::vector<uint8_t>& IntegerNumber::getNumbers() const noexcept {
-    return this->number->getNumbers();
+std::vector<uint8_t> IntegerNumber::getNumbers() const {
+    return this->number.getNumbers();
 }
 
 // Z-8: Умножение целых чисел.
@@ -40,130 +40,94 @@ IntegerNumber IntegerNumber::multiply(const IntegerNumber &other) const {
     uint8_t numberSign = this->getSign();
     uint8_t otherSign = other.getSign();
     if (numberSign == 0 || otherSign == 0) {
-        return IntegerNumber("0");
+        return IntegerNumber(NaturalNumber(), false);
     }
 
-    // Берем модуль числа для умножения и умножаем числа.
-    NaturalNumber numberAbs = this->abs();
-    NaturalNumber otherAbs = other.abs();
-    NaturalNumber multiplyAbs = numberAbs.multiply(otherAbs);
-
     // Вспоминаем, какой знак был у нашего числа.
     // Отрицательное, если знаки у обоих чисел не одинаковые.
     bool resultIsNegative = numberSign != otherSign;
 
-    return IntegerNumber(multiplyAbs.getNumbers(), resultIsNegative);
-}
-
-//Z9: Частное от деления целого на целое (делитель отличен от нуля)
-IntegerNumber IntegerNumber::quotient(const IntegerNumber &other) const {
-    if (other.getSign() == 0) {
-        throw UniversalStringException("you cannot divide by zero");
-    }
-
-    NaturalNumber dividend = this->abs();
-    const NaturalNumber divisor = other.abs();
-
-    if (dividend.cmp(&divisor) == 1) { // divisor > dividend => поделить не можем, вернем 0
-        return IntegerNumber(std::vector<uint8_t>{0}, false);
+    // Произведение чисел в одно слово помещается в два слова и считается без длинной арифметики
+    Limb a, b;
+    if (this->number.toLimb(a) && other.number.toLimb(b)) {
+        return IntegerNumber(NaturalNumber::fromDoubleLimb(static_cast<DoubleLimb>(a) * b), resultIsNegative);
     }
 
-    // Бинарный поиск частного
-    NaturalNumber left("1");
-    NaturalNumber right = dividend; // Максимально возможное частное
-
-    NaturalNumber quotient_natural("0");
-
-    while (left.cmp(&right) != 2) { // left <= right
-        // mid = (left + right) / 2
-        NaturalNumber sum = left.add(right);
-
-        // Реализуем деление на 2 через битовые операции (поразрядное деление)
-        std::vector<uint8_t> sum_digits = sum.getNumbers();
-        std::vector<uint8_t> mid_digits;
-        uint8_t carry = 0;
-
-        // Деление в столбик на 2
-        for (int i = sum_digits.size() - 1; i >= 0; i--) {
-            uint16_t current = sum_digits[i] + carry * 10;
-            uint8_t digit = current / 2;
-            carry = current % 2;
-            mid_digits.push_back(digit);
-        }
-        std::reverse(mid_digits.begin(), mid_digits.end());
+    // Берем модуль числа для умножения и умножаем числа.
+    NaturalNumber multiplyAbs = this->magnitude().multiply(other.magnitude());
 
-        // Убираем ведущие нули
-        while (mid_digits.size() > 1 && mid_digits.back() == 0) {
-            mid_digits.pop_back();
-        }
+    return IntegerNumber(std::move(multiplyAbs), resultIsNegative);
+}
 
-        NaturalNumber mid(mid_digits);
-
-        // product = mid * divisor
-        NaturalNumber product = divisor.multiply(mid);
-
-        int cmp_result = product.cmp(&dividend);
-
-        if (cmp_result == 0) { // product == dividend
-            quotient_natural = mid;
-            break;
-        } else if (cmp_result == 2) { // product > dividend
-            // mid слишком большой, ищем в левой половине
-            NaturalNumber one("1");
-            right = mid.subtract(one);
-        } else { // product < dividend
-            // mid подходит, но может быть большее
-            quotient_natural = mid;
-            NaturalNumber one("1");
-            left = mid.add(one);
-        }
+IntegerNumber &IntegerNumber::operator*=(const IntegerNumber &other) {
+    uint8_t numberSign = this->getSign();
+    uint8_t otherSign = other.getSign();
+    if (numberSign == 0 || otherSign == 0) {
+        this->number = NaturalNumber();
+        this->isNegativeFlag = false;
+        return *this;
     }
-
-    // Конвертируем NaturalNumber в IntegerNumber
-    IntegerNumber result(quotient_natural.getNumbers(), false);
-
-    return this->getSign() != other.getSign() ? result.negate() : result;
+    Limb a, b;
+    if (this->number.toLimb(a) && other.number.toLimb(b))
+        this->number = NaturalNumber::fromDoubleLimb(static_cast<DoubleLimb>(a) * b);
+    else
+        this->number *= other.number;
+    this->isNegativeFlag = numberSign != otherSign;
+    return *this;
 }
 
-//Z10: Остаток от деления целого на целое (делитель отличен от нуля)
-IntegerNumber IntegerNumber::remainder(const IntegerNumber &other) const {
+// Одно деление модулей даёт и частное, и остаток: this = other * quotient + remainder.
+// Округления отличаются от отбрасывания только при ненулевом остатке: модуль частного растёт на 1,
+// а остаток r заменяется на |other| - r с противоположным знаком
+IntegerNumber::DivisionResult IntegerNumber::divmod(const IntegerNumber &other, Rounding rounding) const {
     if (other.getSign() == 0) {
         throw UniversalStringException("you cannot divide by zero");
     }
 
-    const NaturalNumber dividend_abs = this->abs();
-    const NaturalNumber divisor_abs = other.abs();
-
-    // Если делимое меньше делителя по модулю
-    if (dividend_abs.cmp(&divisor_abs) == 1) {
-        // Если делимое отрицательное, корректируем
-        if (this->isNegative()) {
-            return IntegerNumber(divisor_abs.subtract(dividend_abs).getNumbers(), false);
+    NaturalNumber::DivisionResult natural;
+    Limb a, b;
+    if (this->number.toLimb(a) && other.number.toLimb(b))
+        natural = {NaturalNumber(a / b), NaturalNumber(a % b)};
+    else
+        natural = this->number.divmod(other.number);
+
+    // Частное отрицательное, если знаки у чисел не одинаковые, остаток берёт знак делимого
+    const bool signsDiffer = this->getSign() != other.getSign();
+    bool remainderIsNegative = this->getSign() == 1;
+    if (natural.remainder.isNotEqualZero()) {
+        const bool away = rounding == Rounding::Floor ? signsDiffer
+                                                      : rounding == Rounding::Euclidean && remainderIsNegative;
+        if (away) {
+            natural.quotient.increment();
+            natural.remainder = other.number.subtract(natural.remainder);
+            remainderIsNegative = !remainderIsNegative;
         }
-        return *this;
     }
 
-    // Вычисляем частное и произведение
-    const IntegerNumber quotient_result = this->quotient(other);
-    const IntegerNumber product = other.multiply(quotient_result);
-    IntegerNumber remainder = this->subtract(product);
+    const bool quotientIsNegative = natural.quotient.isNotEqualZero() && signsDiffer;
+    remainderIsNegative = remainderIsNegative && natural.remainder.isNotEqualZero();
+    return {IntegerNumber(std::move(natural.quotient), quotientIsNegative),
+            IntegerNumber(std::move(natural.remainder), remainderIsNegative)};
+}
 
-    // Если остаток отрицательный - корректируем (добавляем |divisor|)
-    if (remainder.isNegative()) {
-        remainder = remainder.add(IntegerNumber(divisor_abs.getNumbers(), false));
-    }
+//Z9: Частное от деления целого на целое (делитель отличен от нуля)
+IntegerNumber IntegerNumber::quotient(const IntegerNumber &other) const {
+    return this->divmod(other).quotient;
+}
 
-    return remainder;
+//Z10: Остаток от деления целого на целое (делитель отличен от нуля)
+IntegerNumber IntegerNumber::remainder(const IntegerNumber &other) const {
+    return this->divmod(other, Rounding::Euclidean).remainder;
 }
 
 //Z1: Абсолютная величина числа, результат - натуральное
 NaturalNumber IntegerNumber::abs() const{
-    return NaturalNumber(*this->number);
+    return this->number;
 }
 
 //Z2: Определение положительности числа (2 - положительное, 0 — равное нулю, 1 - отрицательное)
 uint8_t IntegerNumber::getSign() const {
-    if (!this->number->isNotEqualZero()) {
+    if (!this->number.isNotEqualZero()) {
         return 0;
     }
     return this->isNegativeFlag ? 1 : 2;
@@ -171,14 +135,14 @@ uint8_t IntegerNumber::getSign() const {
 
 //Z3: Умножение целого на (-1)
 IntegerNumber IntegerNumber::negate() const {
-    if (!this->number->isNotEqualZero())
+    if (!this->number.isNotEqualZero())
         return *this;
-    return IntegerNumber(this->number->getNumbers(), !this->isNegativeFlag);
+    return IntegerNumber(this->number, !this->isNegativeFlag);
 }
 
 //Z4: Преобразование натурального в целое
 IntegerNumber IntegerNumber::toInteger(const NaturalNumber &other) {
-    return IntegerNumber(other.getNumbers(), false);
+    return IntegerNumber(other, false);
 }
 
 //Z5: Преобразование целого неотрицательного в натуральное
@@ -186,36 +150,88 @@ NaturalNumber IntegerNumber::toNatural(const IntegerNumber& other) const {
     if (other.isNegativeFlag) {
         throw UniversalStringException("to convert an integer to a natural, it must be greater than or equal to 0.");
     }
-    return NaturalNumber(*other.number);
+    return other.number;
 }
 
 //Z6: Сложение целых чисел
 IntegerNumber IntegerNumber::add(const IntegerNumber &other) const {
-    NaturalNumber absThis = this->abs();
-    NaturalNumber absOther = other.abs();
-    size_t maxSize = std::max(absThis.getNumbers().size(), absOther.getNumbers().size());
-    std::vector<uint8_t> resultNumbers(maxSize + 1, 0);
-
-    if (this->getSign() == other.getSign()) {
-        NaturalNumber sum = absThis.add(absOther);
-        bool isNeg = this->isNegativeFlag;
-        return IntegerNumber(sum.getNumbers(), isNeg);
+    IntegerNumber result(*this);
+    result.addInPlace(other);
+    return result;
+}
+
+IntegerNumber &IntegerNumber::addInPlace(const IntegerNumber &other) {
+    this->addSignedInPlace(other.number, other.getSign());
+    return *this;
+}
+
+void IntegerNumber::addSignedInPlace(const NaturalNumber &magnitude, uint8_t sign) {
+    // Для чисел в одно слово сумма по модулю меньше 2^65 и точно считается в 128-битном знаковом
+    Limb a, b;
+    if (this->number.toLimb(a) && magnitude.toLimb(b)) {
+        const __int128 sum = (this->getSign() == 1 ? -static_cast<__int128>(a) : static_cast<__int128>(a)) +
+                             (sign == 1 ? -static_cast<__int128>(b) : static_cast<__int128>(b));
+        this->number = NaturalNumber::fromDoubleLimb(static_cast<DoubleLimb>(sum < 0 ? -sum : sum));
+        this->isNegativeFlag = sum < 0;
+        return;
+    }
+    if (this->getSign() == sign) {
+        this->number.addInPlace(magnitude);
+        return;
+    }
+    uint8_t cmp = this->number.cmp(&magnitude);
+    if (cmp == 0) {
+        this->number = NaturalNumber();
+        this->isNegativeFlag = false;
+    } else if (cmp == 2) {
+        this->number.subInPlace(magnitude);
     } else {
-        uint8_t cmp = absThis.cmp(&absOther);
-        if (cmp == 0) {
-            return IntegerNumber(std::vector<uint8_t>{0}, false);
-        } else if (cmp == 2) {
-            NaturalNumber diff = absThis.subtract(absOther);
-            return IntegerNumber(diff.getNumbers(), this->isNegativeFlag);
-        } else {
-            NaturalNumber diff = absOther.subtract(absThis);
-            return IntegerNumber(diff.getNumbers(), other.isNegativeFlag);
-        }
+        NaturalNumber diff(magnitude);
+        diff.subInPlace(this->number);
+        this->number = std::move(diff);
+        this->isNegativeFlag = sign == 1;
+    }
+}
+
+IntegerNumber &IntegerNumber::addmul(const IntegerNumber &a, const IntegerNumber &b) {
+    this->addProductInPlace(a, b, false);
+    return *this;
+}
+
+IntegerNumber &IntegerNumber::submul(const IntegerNumber &a, const IntegerNumber &b) {
+    this->addProductInPlace(a, b, true);
+    return *this;
+}
+
+// При одинаковых знаках модуль произведения прибавляется, при разных - вычитается, и знак результата
+// меняется, только если произведение оказалось больше по модулю
+void IntegerNumber::addProductInPlace(const IntegerNumber &a, const IntegerNumber &b, bool negate) {
+    const uint8_t aSign = a.getSign();
+    const uint8_t bSign = b.getSign();
+    if (aSign == 0 || bSign == 0)
+        return;
+    const bool productIsNegative = (aSign != bSign) != negate;
+    const uint8_t sign = this->getSign();
+    if (sign == 0 || (sign == 1) == productIsNegative) {
+        this->number.addmul(a.number, b.number);
+        this->isNegativeFlag = productIsNegative;
+    } else if (this->number.submulAbs(a.number, b.number)) {
+        this->isNegativeFlag = productIsNegative;
+    } else if (!this->number.isNotEqualZero()) {
+        this->isNegativeFlag = false;
     }
 }
 
 //Z7: Вычитание целых чисел
 IntegerNumber IntegerNumber::subtract(const IntegerNumber& other) const {
-    IntegerNumber negOther = other.negate();
-    return this->add(negOther);
+    IntegerNumber result(*this);
+    result.subInPlace(other);
+    return result;
+}
+
+IntegerNumber &IntegerNumber::subInPlace(const IntegerNumber &other) {
+    // Вычитание - сложение с числом противоположного знака
+    uint8_t sign = other.getSign();
+    this->addSignedInPlace(other.number, sign == 0 ? 0 : 3 - sign);
+    return *this;
 }
\ No newline at end of file
@@ -10,42 +10,43 @@
 
     class IntegerNumber {
     public:
-        IntegerNumber(const std::vector<uint8_t>& numbers, bool isNegative): isNegativeFlag(isNegative){
-            this->number = new NaturalNumber(numbers);
+        struct DivisionResult; //частное и остаток одного деления
+
+        // Округление частного при делении: a = b * q + r
+        enum class Rounding {
+            Truncate, //q к нулю, знак r как у делимого
+            Floor, //q вниз, знак r как у делителя
+            Euclidean //0 <= r < |b|
         };
+
+        IntegerNumber(const std::vector<uint8_t>& numbers, bool isNegative): number(numbers), isNegativeFlag(isNegative) {}
+        IntegerNumber(const NaturalNumber& magnitude, bool isNegative): number(magnitude), isNegativeFlag(isNegative) {}
+        IntegerNumber(NaturalNumber&& magnitude, bool isNegative): number(std::move(magnitude)), isNegativeFlag(isNegative) {}
         IntegerNumber(const std::string& s); //основной конструктор
         IntegerNumber(long long a); //решение для облегченного тестирования, потом будет выпелено
 
-        IntegerNumber(const IntegerNumber& other): isNegativeFlag(other.isNegativeFlag), number(new NaturalNumber(*other.number)) {}
-        IntegerNumber(IntegerNumber&& other) noexcept: isNegativeFlag(other.isNegativeFlag), number(other.number) {other.number = nullptr;}
-
-        IntegerNumber& operator=(const IntegerNumber& other) {
-            if (this != &other) {
-                delete this->number;
-                this->number = new NaturalNumber(*other.number);
-                this->isNegativeFlag = other.isNegativeFlag;
-            }
-            return *this;
+        // Модуль хранится в самом объекте: копия делит буфер слов (см. LimbStorage), перемещённое число становится нулём
+        IntegerNumber(const IntegerNumber& other) = default;
+        IntegerNumber(IntegerNumber&& other) noexcept: number(std::move(other.number)), isNegativeFlag(other.isNegativeFlag) {
+            other.isNegativeFlag = false;
         }
+
+        IntegerNumber& operator=(const IntegerNumber& other) = default;
         IntegerNumber& operator=(IntegerNumber&& other) noexcept {
             if (this != &other) {
-                delete this->number;
-                this->number = other.number;
+                this->number = std::move(other.number);
                 this->isNegativeFlag = other.isNegativeFlag;
-                other.number = nullptr;
+                other.isNegativeFlag = false;
             }
             return *this;
         }
 
-        ~IntegerNumber() {
-            delete this->number;
-        }
-
 
         bool isNegative() const noexcept;
         std::string toString() const;
-        const std::vector<uint8_t>& getNumbers() const noexcept;
+        std::vector<uint8_t> getNumbers() const;
         NaturalNumber abs() const;
+        const NaturalNumber& magnitude() const noexcept { return this->number; } //модуль без копирования
         uint8_t getSign() const;
         IntegerNumber negate() const;
         static IntegerNumber toInteger(const NaturalNumber& other);
@@ -53,13 +54,31 @@
         IntegerNumber add(const IntegerNumber& other) const;
         IntegerNumber subtract(const IntegerNumber& other) const;
         IntegerNumber multiply(const IntegerNumber& other) const;
-        IntegerNumber quotient(const IntegerNumber& other) const;
-        IntegerNumber remainder(const IntegerNumber& other) const;
+
+        // Изменяющие варианты операций: результат пишется в текущее число, его память переиспользуется
+        IntegerNumber& addInPlace(const IntegerNumber& other);
+        IntegerNumber& subInPlace(const IntegerNumber& other);
+        IntegerNumber& operator+=(const IntegerNumber& other) { return this->addInPlace(other); }
+        IntegerNumber& operator-=(const IntegerNumber& other) { return this->subInPlace(other); }
+        IntegerNumber& operator*=(const IntegerNumber& other);
+        IntegerNumber& addmul(const IntegerNumber& a, const IntegerNumber& b); //this += a * b без промежуточного произведения
+        IntegerNumber& submul(const IntegerNumber& a, const IntegerNumber& b); //this -= a * b
+        DivisionResult divmod(const IntegerNumber& other, Rounding rounding = Rounding::Truncate) const;
+        IntegerNumber quotient(const IntegerNumber& other) const; //с отбрасыванием дробной части
+        IntegerNumber remainder(const IntegerNumber& other) const; //неотрицательный, как при Rounding::Euclidean
 
 
     private:
-        NaturalNumber *number;
-        bool isNegativeFlag;
+        NaturalNumber number;
+        bool isNegativeFlag = false;
+
+        void addSignedInPlace(const NaturalNumber& magnitude, uint8_t sign); //sign как у getSign
+        void addProductInPlace(const IntegerNumber& a, const IntegerNumber& b, bool negate); //this += (-1)^negate * a * b
+    };
+
+    struct IntegerNumber::DivisionResult {
+        IntegerNumber quotient;
+        IntegerNumber remainder;
     };
 
 
@@ -4,153 +4,219 @@
 
 #include "NaturalNumber.h"
 #include "Exceptions/UniversalStringException.h"
+#include "Arithmetic/Multiplication.h"
+#include "Arithmetic/Division.h"
+#include "Arithmetic/GreatestCommonDivisor.h"
+#include "Arithmetic/RadixConversion.h"
+#include "Arithmetic/Exponentiation.h"
+#include "Arithmetic/Roots.h"
+#include "Arithmetic/ProductTree.h"
+#include "Arithmetic/Combinatorics.h"
 #include <cmath>
 #include <algorithm>
 
-std::string NaturalNumber::toString() {
-    if (this->numbers.empty())
-        throw UniversalStringException("atypical behavior, the vector of numbers should not be empty");
-    std::string result(this->numbers.size(), '0');
-    for (int i = this->numbers.size() - 1; i >= 0; --i) {
-        result[this->numbers.size() - i - 1] = '0' + this->numbers.at(i);
+namespace {
+    // Хвост из стольких нулей во входной строке не переводится, а становится отложенным множителем
+    constexpr std::size_t LAZY_SCALE_MIN_DIGITS = LimbArithmetic::DECIMAL_BASE_DIGITS;
+    // До стольких цифр отложенный множитель вносится умножениями на слово, дальше - одним умножением на 10^k
+    constexpr std::size_t SHORT_SCALE_DIGITS = 4 * LimbArithmetic::DECIMAL_BASE_DIGITS;
+    const double LOG2_10 = 3.32192809488736234787;
+
+    std::size_t addScales(std::size_t a, std::size_t b) {
+        if (b > SIZE_MAX - a)
+            throw UniversalStringException("The size of number is greater then " + std::to_string(SIZE_MAX));
+        return a + b;
     }
+
+    // r[0..rn) += a * b или r[0..rn) -= a * b при rn >= an + bn, возвращает перенос (заём) из старшего слова.
+    // Короткие множители умножаются в столбик, и каждая строка сразу прибавляется к r без буфера произведения
+    Limb accumulateProduct(Limb *r, std::size_t rn, const Limb *a, std::size_t an, const Limb *b, std::size_t bn,
+                           bool subtract) {
+        if (an < bn) {
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+        if (bn >= Multiplication::getThresholds().karatsuba) {
+            std::vector<Limb> product(an + bn);
+            Multiplication::multiply(product.data(), a, an, b, bn);
+            return subtract ? LimbArithmetic::sub(r, r, rn, product.data(), product.size())
+                            : LimbArithmetic::add(r, r, rn, product.data(), product.size());
+        }
+        Limb carry = 0;
+        for (std::size_t i = 0; i < bn; ++i) {
+            Limb *row = r + i;
+            const Limb high = subtract ? LimbArithmetic::subMul1(row, a, an, b[i]) : LimbArithmetic::addMul1(row, a, an, b[i]);
+            carry += subtract ? LimbArithmetic::sub1(row + an, row + an, rn - i - an, high)
+                              : LimbArithmetic::add1(row + an, row + an, rn - i - an, high);
+        }
+        return carry;
+    }
+}
+
+// Длинные числа переводятся делением пополам на кэшированные степени 10^19, см. RadixConversion
+std::string NaturalNumber::toString() const {
+    std::string result = RadixConversion::toDecimal(this->mantissa().data(), this->mantissa().size());
+    // Отложенный множитель 10^k - это k нулей в конце записи
+    result.append(this->decimalScale, '0');
     return result;
 }
 
-const std::vector<uint8_t> &NaturalNumber::getNumbers() const noexcept {
-    return this->numbers;
+std::vector<uint8_t> NaturalNumber::getNumbers() const {
+    const std::string decimal = this->toString();
+    std::vector<uint8_t> result(decimal.size());
+    for (std::size_t i = 0; i < decimal.size(); ++i) {
+        result[decimal.size() - i - 1] = decimal[i] - '0';
+    }
+    return result;
 }
 
 NaturalNumber::NaturalNumber(unsigned long long int a) {
-    if (a == 0) {
-        this->numbers.push_back(0);
-    }
-    while (a > 0) {
-        this->numbers.push_back(a % 10);
-        a /= 10;
-    }
+    if (a != 0)
+        this->limbs.push_back(a);
 }
 
 NaturalNumber::NaturalNumber(const std::string &a) {
     if (a.empty())
         throw UniversalStringException("wrong argument, the string of numbers should not be empty");
-    this->numbers = std::vector<uint8_t>(a.size());
-    std::size_t i = a.length() - 1;
-    while (true) {
-        numbers[a.size() - i - 1] = a[i] - '0';
-        if (i != 0)
-            i--;
-        else
-            break;
-    }
+    std::size_t significant = a.size();
+    while (significant > 1 && a[significant - 1] == '0')
+        --significant;
+    if (a.size() - significant < LAZY_SCALE_MIN_DIGITS)
+        significant = a.size();
+    this->limbs = RadixConversion::fromDecimal(a.data(), significant);
+    if (!this->limbs.empty())
+        this->decimalScale = a.size() - significant;
 }
 
 NaturalNumber::NaturalNumber(const std::vector<uint8_t> &CpNumbers) {
     if (CpNumbers.empty())
         throw UniversalStringException("wrong argument, the vector of numbers should not be empty");
-    this->numbers = CpNumbers;
 
-    //проверка лишняя, тк из условия корректности числа такого быть не должно, но во избежание багов от некоторых участиников проекта пусть будет
-    while (this->numbers.size() > 1 && this->numbers.back() == 0) {
-        this->numbers.pop_back();
-    }
+    // Цифры лежат от младшей к старшей, переводу нужна запись от старшей
+    std::string decimal(CpNumbers.size(), '0');
+    for (std::size_t i = 0; i < CpNumbers.size(); ++i)
+        decimal[CpNumbers.size() - i - 1] = static_cast<char>('0' + CpNumbers[i]);
+    this->limbs = RadixConversion::fromDecimal(decimal.data(), decimal.size());
 }
 
+void NaturalNumber::normalize() {
+    this->limbs.resize(LimbArithmetic::normalizedSize(this->limbs.data(), this->limbs.size()));
+}
 
-//N11: Неполное частное от деления первого натурального числа на второе с остатком (делитель отличен от нуля)
-NaturalNumber NaturalNumber::quotient(const NaturalNumber &other) const {
-    if (!other.isNotEqualZero()) {
-        throw UniversalStringException("can not divide by zero");
-    }
+// Длина слов без отложенного множителя
+std::size_t NaturalNumber::bitLength() const {
+    if (this->mantissa().empty())
+        return 0;
+    return this->mantissa().size() * LimbArithmetic::LIMB_BITS - LimbArithmetic::countLeadingZeros(this->mantissa().back());
+}
 
-    // Если делимое меньше делителя → частное = 0
-    if (this->cmp(&other) == 1) {
-        return NaturalNumber(std::vector<uint8_t>{0});
-    }
-
-    NaturalNumber dividend(*this);
-    NaturalNumber divisor(other);
-
-    std::vector<uint8_t> result;  // цифры частного
-    result.reserve(dividend.getNumbers().size());
-
-    NaturalNumber current(std::vector<uint8_t>{0});
-    const std::vector<uint8_t>& dividendDigits = dividend.getNumbers();
-
-    // идем от старших цифр к младшим (как в ручном делении)
-    for (int i = static_cast<int>(dividendDigits.size()) - 1; i >= 0; --i) {
-        // "сдвигаем" остаток на одну позицию влево (умножаем на 10)
-        current = current.multiplyByPowerOfTen(1);
-        current = current.add(NaturalNumber(std::vector<uint8_t>{dividendDigits[i]}));
-
-        // ищем максимальную цифру q, такую что divisor * q <= current
-        uint8_t q = 0;
-
-        if (current.cmp(&divisor) != 1) {
-            for (int digit = 9; digit >= 1; --digit) { // int — важно
-                NaturalNumber candidate = divisor.multiplyByDigit(static_cast<std::size_t>(digit));
-                try {
-                    // пытаемся вычесть — если candidate > current, subtract бросит
-                    NaturalNumber newCurrent = current.subtract(candidate);
-                    q = static_cast<uint8_t>(digit);
-                    current = std::move(newCurrent);
-                    break;
-                } catch (const UniversalStringException &) {
-                    // candidate > current — пробуем меньшую цифру
-                    continue;
-                }
-            }
-        }
+std::size_t NaturalNumber::decimalDigitCount() const {
+    std::size_t bits = this->bitLength();
+    if (bits == 0)
+        return 1;
+    // (bits - 1) * lg2 даёт нижнюю оценку, ошибаемся не больше чем на одну цифру.
+    // Отложенный множитель добавляет ровно decimalScale цифр
+    auto digits = static_cast<std::size_t>(static_cast<double>(bits - 1) * 0.30102999566398119521) + 1;
+    NaturalNumber significand;
+    significand.limbs = this->mantissa();
+    NaturalNumber bound = NaturalNumber(1).multiplyByPowerOfTen(digits);
+    return (significand.cmp(&bound) == 1 ? digits : digits + 1) + this->decimalScale;
+}
+
+// Само число не меняется: 10^100000 остаётся коротким, а константные методы можно звать из разных потоков
+std::vector<Limb> NaturalNumber::digits() const {
+    if (this->decimalScale == 0)
+        return this->mantissa().toVector();
+    return this->withScale(0).mantissa().toVector();
+}
 
-        result.push_back(q);
+NaturalNumber NaturalNumber::withScale(std::size_t scale) const {
+    NaturalNumber result;
+    result.limbs = this->mantissa();
+    result.decimalScale = scale;
+    std::size_t k = this->decimalScale - scale;
+    if (k <= SHORT_SCALE_DIGITS) {
+        // Умножаем блоками по 10^19, последний блок - на оставшуюся степень десяти
+        while (k > 0) {
+            unsigned step = k >= LimbArithmetic::DECIMAL_BASE_DIGITS ? LimbArithmetic::DECIMAL_BASE_DIGITS
+                                                                     : static_cast<unsigned>(k);
+            result.mulSmallInPlace(powerOfTen(step));
+            k -= step;
+        }
+        return result;
     }
-    // результат записан в обратном порядке (с младших к старшим)
-    std::reverse(result.begin(), result.end());
-    // убираем ведущие нули
-    while (result.size() > 1 && result.back() == 0) {
-        result.pop_back();
+    const Limb exponent = k;
+    NaturalNumber factor;
+    try {
+        factor.limbs = Exponentiation::power(std::vector<Limb>{10}, &exponent, 1);
+    } catch (const std::bad_alloc &e) {
+        throw UniversalStringException("Not enough memory to multiply by power of ten");
     }
+    return result.multiply(factor);
+}
 
-    return NaturalNumber(result);
+Limb NaturalNumber::powerOfTen(unsigned k) {
+    Limb result = 1;
+    while (k-- > 0)
+        result *= 10;
+    return result;
 }
 
-//N12: Остаток от деления первого натурального числа на второе натуральное (делитель отличен от нуля)
-NaturalNumber NaturalNumber::remainder(const NaturalNumber &other) const {
+
+// Частное и остаток за одно деление: алгоритм D Кнута или умножение на обратное оставляют остаток
+// в рабочем буфере, поэтому восстанавливать его через умножение и вычитание не нужно
+NaturalNumber::DivisionResult NaturalNumber::divmod(const NaturalNumber &other) const {
     if (!other.isNotEqualZero()) {
         throw UniversalStringException("can not divide by zero");
     }
 
-    if (cmp(&other) == 1) return *this;
+    // Если делимое меньше делителя → частное = 0, остаток = делимое
+    if (this->cmp(&other) == 1) {
+        return {NaturalNumber(), *this};
+    }
 
-    NaturalNumber dividend(*this);
-    const NaturalNumber &divisor(other);
+    // Общий множитель 10^t сокращается в частном и остаётся множителем остатка
+    const std::size_t common = std::min(this->decimalScale, other.decimalScale);
+    const NaturalNumber dividend = this->withScale(common);
+    const NaturalNumber divisor = other.withScale(common);
+    const LimbStorage &a = dividend.mantissa();
+    const LimbStorage &b = divisor.mantissa();
+
+    DivisionResult result;
+    result.quotient.limbs.resize(a.size() - b.size() + 1);
+    result.remainder.limbs.resize(b.size());
+    Division::divideRemainder(result.quotient.limbs.data(), result.remainder.limbs.data(),
+                              a.data(), a.size(), b.data(), b.size());
+    result.quotient.normalize();
+    result.remainder.normalize();
+    if (result.remainder.isNotEqualZero())
+        result.remainder.decimalScale = common;
+    return result;
+}
 
-    const NaturalNumber quotient = dividend.quotient(divisor);
-    const NaturalNumber product = divisor.multiply(quotient);
+//N11: Неполное частное от деления первого натурального числа на второе с остатком (делитель отличен от нуля)
+NaturalNumber NaturalNumber::quotient(const NaturalNumber &other) const {
+    return this->divmod(other).quotient;
+}
 
-    return dividend.subtract(product);
+//N12: Остаток от деления первого натурального числа на второе натуральное (делитель отличен от нуля)
+NaturalNumber NaturalNumber::remainder(const NaturalNumber &other) const {
+    return this->divmod(other).remainder;
 }
 
 //N13: НОД натуральных чисел
 NaturalNumber NaturalNumber::GCD(const NaturalNumber &other) const {
-    NaturalNumber first_value(*this);
-    NaturalNumber second_value(other);
-
     if (!this->isNotEqualZero() && !other.isNotEqualZero()) {
         throw UniversalStringException("the gcd for two zeros is not uniquely defined");
     }
 
-    if (!second_value.isNotEqualZero()) {
-        return first_value;
-    }
-    // алгоритм Евклида
-    while (second_value.isNotEqualZero()) {
-        NaturalNumber tmp = first_value.remainder(second_value);
-        first_value = second_value;
-        second_value = tmp;
+    if (!other.isNotEqualZero()) {
+        return *this;
     }
-
-    return first_value;
+    // бинарный алгоритм для коротких чисел, Лемер и half-GCD для длинных
+    NaturalNumber result;
+    result.limbs = GreatestCommonDivisor::gcd(this->digits(), other.digits());
+    return result;
 }
 
 //N14: НОК натуральных чисел
@@ -165,79 +231,305 @@ NaturalNumber NaturalNumber::LCM(const NaturalNumber &other) const {
     return (first_value.multiply(second_value)).quotient(first_value.GCD(second_value));
 }
 
+// Множители перемножаются по дереву произведений, отложенные множители 10^k складываются
+NaturalNumber NaturalNumber::productOf(const std::vector<NaturalNumber> &values) {
+    std::vector<std::vector<Limb>> mantissas;
+    mantissas.reserve(values.size());
+    std::size_t scale = 0;
+    for (const NaturalNumber &value : values) {
+        if (!value.isNotEqualZero())
+            return NaturalNumber();
+        mantissas.push_back(value.mantissa().toVector());
+        scale = addScales(scale, value.decimalScale);
+    }
+    NaturalNumber result;
+    result.limbs = ProductTree::product(mantissas);
+    result.decimalScale = scale;
+    return result;
+}
+
+NaturalNumber NaturalNumber::lcmOf(const std::vector<NaturalNumber> &values) {
+    std::vector<std::vector<Limb>> numbers;
+    numbers.reserve(values.size());
+    for (const NaturalNumber &value : values) {
+        if (!value.isNotEqualZero())
+            throw UniversalStringException("the lcm for zeros is not uniquely defined");
+        numbers.push_back(value.digits());
+    }
+    NaturalNumber result;
+    result.limbs = ProductTree::lcm(numbers);
+    return result;
+}
+
+// Свёртка начинается с самого короткого числа: НОД не длиннее его, и каждый шаг дёшев
+NaturalNumber NaturalNumber::gcdOf(const std::vector<NaturalNumber> &values) {
+    const NaturalNumber *shortest = nullptr;
+    for (const NaturalNumber &value : values) {
+        if (value.isNotEqualZero() && (shortest == nullptr || value.cmp(shortest) == 1))
+            shortest = &value;
+    }
+    if (shortest == nullptr)
+        throw UniversalStringException("the gcd for two zeros is not uniquely defined");
+
+    std::vector<Limb> result = shortest->digits();
+    for (const NaturalNumber &value : values) {
+        if (result.size() == 1 && result[0] == 1)
+            break;
+        if (&value != shortest && value.isNotEqualZero())
+            result = GreatestCommonDivisor::gcd(std::move(result), value.digits());
+    }
+    NaturalNumber gcd;
+    gcd.limbs = result;
+    return gcd;
+}
+
+std::vector<NaturalNumber> NaturalNumber::remainders(const std::vector<NaturalNumber> &moduli) const {
+    std::vector<std::vector<Limb>> numbers;
+    numbers.reserve(moduli.size());
+    for (const NaturalNumber &modulus : moduli) {
+        if (!modulus.isNotEqualZero())
+            throw UniversalStringException("can not divide by zero");
+        numbers.push_back(modulus.digits());
+    }
+    std::vector<std::vector<Limb>> rests = ProductTree::remainders(this->digits(), numbers);
+    std::vector<NaturalNumber> result(rests.size());
+    for (std::size_t i = 0; i < rests.size(); ++i)
+        result[i].limbs = rests[i];
+    return result;
+}
+
+NaturalNumber NaturalNumber::factorial(std::size_t n) {
+    if (n > UINT32_MAX)
+        throw UniversalStringException("the argument of factorial is too large");
+    NaturalNumber result;
+    result.limbs = Combinatorics::factorial(static_cast<std::uint32_t>(n));
+    return result;
+}
+
+NaturalNumber NaturalNumber::binomial(std::size_t n, std::size_t k) {
+    if (k > n)
+        return NaturalNumber();
+    if (n > UINT32_MAX)
+        throw UniversalStringException("the argument of binomial coefficient is too large");
+    NaturalNumber result;
+    result.limbs = Combinatorics::binomial(static_cast<std::uint32_t>(n), static_cast<std::uint32_t>(k));
+    return result;
+}
+
+NaturalNumber NaturalNumber::primorial(std::size_t n) {
+    if (n > UINT32_MAX)
+        throw UniversalStringException("the argument of primorial is too large");
+    NaturalNumber result;
+    result.limbs = Combinatorics::primorial(static_cast<std::uint32_t>(n));
+    return result;
+}
+
+// Возведение в степень скользящим окном, см. Exponentiation
+NaturalNumber NaturalNumber::pow(const NaturalNumber &exponent) const {
+    const std::vector<Limb> power = exponent.digits();
+    NaturalNumber result;
+    result.limbs = Exponentiation::power(this->digits(), power.data(), power.size());
+    return result;
+}
+
+// Для нечётного модуля умножения идут в форме Монтгомери и не требуют деления
+NaturalNumber NaturalNumber::modPow(const NaturalNumber &exponent, const NaturalNumber &modulus) const {
+    if (!modulus.isNotEqualZero()) {
+        throw UniversalStringException("can not divide by zero");
+    }
+    const std::vector<Limb> power = exponent.digits();
+    NaturalNumber result;
+    result.limbs = Exponentiation::modPower(this->digits(), power.data(), power.size(), modulus.digits());
+    return result;
+}
+
+NaturalNumber NaturalNumber::isqrt() const {
+    return this->iroot(2);
+}
+
+// Корни считаются итерациями Ньютона от приближения по старшим битам, см. Roots
+NaturalNumber NaturalNumber::iroot(std::size_t k) const {
+    if (k == 0) {
+        throw UniversalStringException("NaturalNumber::iroot: the degree of the root must be positive");
+    }
+    NaturalNumber result;
+    result.limbs = Roots::root(this->digits(), k);
+    return result;
+}
+
+bool NaturalNumber::isPerfectPower() const {
+    return Roots::isPerfectPower(this->digits());
+}
+
 //  N1: Сравнение чисел: 2 — текущее больше, 1 — текущее меньше, 0 — равны.
 uint8_t NaturalNumber::cmp(const NaturalNumber *other) const {
-    // По условию экземпляры валидные и не содержат незначащих нулей,
-    // поэтому сравниваем прямо по длине и по цифрам.
-    if (this->numbers.size() > other->numbers.size()) return 2;
-    if (this->numbers.size() < other->numbers.size()) return 1;
-
-    // Длины равны — сравниваем по старшему разряду к младшему.
-    for (size_t i = this->numbers.size(); i-- > 0;) {
-        uint8_t a = this->numbers[i];
-        uint8_t b = other->numbers[i];
-        if (a > b) return 2;
-        if (a < b) return 1;
+    // По условию экземпляры валидные и не содержат незначащих слов,
+    // поэтому при равных множителях сравниваем прямо по длине и по словам.
+    int result;
+    if (this->decimalScale == other->decimalScale) {
+        result = LimbArithmetic::compare(this->mantissa().data(), this->mantissa().size(),
+                                         other->mantissa().data(), other->mantissa().size());
+    } else if (!this->isNotEqualZero() || !other->isNotEqualZero()) {
+        result = this->isNotEqualZero() ? 1 : -1;
+    } else {
+        // Если длины значений в битах заведомо различаются, хватает оценки,
+        // иначе меньший множитель выносится за скобки и сравниваются выровненные слова
+        const double thisBits = static_cast<double>(this->bitLength()) + static_cast<double>(this->decimalScale) * LOG2_10;
+        const double otherBits = static_cast<double>(other->bitLength()) + static_cast<double>(other->decimalScale) * LOG2_10;
+        if (thisBits > otherBits + 2) {
+            result = 1;
+        } else if (otherBits > thisBits + 2) {
+            result = -1;
+        } else {
+            const std::size_t common = std::min(this->decimalScale, other->decimalScale);
+            const NaturalNumber a = this->withScale(common);
+            const NaturalNumber b = other->withScale(common);
+            result = LimbArithmetic::compare(a.mantissa().data(), a.mantissa().size(),
+                                             b.mantissa().data(), b.mantissa().size());
+        }
     }
+    if (result > 0) return 2;
+    if (result < 0) return 1;
     return 0;
 }
 
 //N3: Добавление 1 к натуральному числу
 void NaturalNumber::increment() {
-    uint8_t carry = 1;
-    for (size_t i = 0; i < this->numbers.size() && carry; ++i) {
-        uint8_t sum = this->numbers[i] + carry;
-        this->numbers[i] = sum % 10;
-        carry = sum / 10;
-    }
-    if (carry) this->numbers.push_back(carry);
+    if (this->decimalScale != 0)
+        *this = this->withScale(0);
+    Limb carry = LimbArithmetic::add1(this->limbs.data(), this->limbs.data(), this->limbs.size(), 1);
+    if (carry) this->limbs.push_back(carry);
 }
 
 //N4: Сложение натуральных чисел
 NaturalNumber NaturalNumber::add(const NaturalNumber &other) const {
-    size_t n = this->numbers.size();
-    size_t m = other.numbers.size();
-    size_t maxlen = std::max(n, m);
-    std::vector<uint8_t> res;
-    res.reserve(maxlen + 1);
-    uint8_t carry = 0;
-
-    // Складываем цифры по разрядам
-    for (size_t i = 0; i < maxlen; ++i) {
-        uint8_t a = (i < n) ? this->numbers[i] : 0;
-        uint8_t b = (i < m) ? other.numbers[i] : 0;
-        uint8_t s = a + b + carry;
-        res.push_back(s % 10);
-        carry = s / 10;
+    NaturalNumber result;
+    if (this->decimalScale == other.decimalScale) {
+        result.limbs.reserve(std::max(this->mantissa().size(), other.mantissa().size()) + 1);
+        result.limbs.assign(this->mantissa().data(), this->mantissa().size());
+        result.decimalScale = this->decimalScale;
+    } else {
+        result = *this;
     }
-    if (carry) res.push_back(carry);
-    return NaturalNumber(res);
+    result.addInPlace(other);
+    return result;
+}
+
+NaturalNumber &NaturalNumber::addInPlace(const NaturalNumber &other) {
+    if (!other.isNotEqualZero())
+        return *this;
+    if (!this->isNotEqualZero())
+        return *this = other;
+    // Слагаемые приводятся к меньшему из множителей, сумма сохраняет его
+    if (this->decimalScale > other.decimalScale)
+        *this = this->withScale(other.decimalScale);
+    else if (this->decimalScale < other.decimalScale)
+        return this->addInPlace(other.withScale(this->decimalScale));
+
+    const std::size_t otherSize = other.mantissa().size();
+    if (this->limbs.size() < otherSize)
+        this->limbs.resize(otherSize, 0);
+    Limb carry = LimbArithmetic::add(this->limbs.data(), this->limbs.data(), this->limbs.size(),
+                                     other.mantissa().data(), otherSize);
+    if (carry) this->limbs.push_back(carry);
+    return *this;
 }
 
 //N5: Вычитание из первого большего натурального числа второго меньшего или равного
 //  Если второе больше первого — ошибка.
 NaturalNumber NaturalNumber::subtract(const NaturalNumber &other) const {
+    NaturalNumber result(*this);
+    result.subInPlace(other);
+    return result;
+}
+
+NaturalNumber &NaturalNumber::subInPlace(const NaturalNumber &other) {
     uint8_t comparison = this->cmp(&other);
     if (comparison == 1) {
         std::string msg = "NaturalNumber::SUB_NN_N: subtrahend larger than minuend";
         throw UniversalStringException(msg);
     }
-    if (comparison == 0) return NaturalNumber(std::vector<uint8_t>{0});
-    std::vector<uint8_t> res(this->numbers.size(), 0);
-    int borrow = 0;
-    for (size_t i = 0; i < this->numbers.size(); ++i) {
-        int a = this->numbers[i];
-        int b = (i < other.numbers.size()) ? other.numbers[i] : 0;
-        int diff = a - b - borrow;
-        if (diff < 0) {
-            diff += 10;
-            borrow = 1;
-        } else {
-            borrow = 0;
+    if (comparison == 0) {
+        this->limbs.clear();
+        this->decimalScale = 0;
+        return *this;
+    }
+    if (!other.isNotEqualZero())
+        return *this;
+    const NaturalNumber *subtrahend = &other;
+    NaturalNumber aligned;
+    if (this->decimalScale > other.decimalScale) {
+        *this = this->withScale(other.decimalScale);
+    } else if (this->decimalScale < other.decimalScale) {
+        aligned = other.withScale(this->decimalScale);
+        subtrahend = &aligned;
+    }
+    LimbArithmetic::sub(this->limbs.data(), this->limbs.data(), this->limbs.size(),
+                        subtrahend->mantissa().data(), subtrahend->mantissa().size());
+    this->normalize();
+    return *this;
+}
+
+// Произведение копится прямо в словах текущего числа, без промежуточного NaturalNumber
+NaturalNumber &NaturalNumber::addmul(const NaturalNumber &a, const NaturalNumber &b) {
+    if (!a.isNotEqualZero() || !b.isNotEqualZero())
+        return *this;
+    // Отложенные множители и совпадение с множителем идут общим путём
+    if (&a == this || &b == this || this->decimalScale != 0 || a.decimalScale != 0 || b.decimalScale != 0)
+        return this->addInPlace(a.multiply(b));
+
+    const std::size_t an = a.mantissa().size();
+    const std::size_t bn = b.mantissa().size();
+    const std::size_t size = std::max(this->limbs.size(), an + bn) + 1;
+    this->limbs.resize(size, 0);
+    accumulateProduct(this->limbs.data(), size, a.mantissa().data(), an, b.mantissa().data(), bn, false);
+    this->normalize();
+    return *this;
+}
+
+// Проверка идёт до изменения числа, поэтому при ошибке оно остаётся прежним.
+// Если в числе больше бит, чем в двух множителях вместе, произведение заведомо меньше и считается на месте
+NaturalNumber &NaturalNumber::submul(const NaturalNumber &a, const NaturalNumber &b) {
+    if (this->decimalScale == 0 && a.decimalScale == 0 && b.decimalScale == 0 &&
+        this->bitLength() > a.bitLength() + b.bitLength()) {
+        this->submulAbs(a, b);
+        return *this;
+    }
+    const NaturalNumber product = a.multiply(b);
+    if (this->cmp(&product) == 1)
+        throw UniversalStringException("NaturalNumber::submul: subtrahend larger than minuend");
+    return this->subInPlace(product);
+}
+
+// Заём из старшего слова значит, что a * b больше: в словах лежит x - a * b + B^size,
+// и модуль разности получается дополнением до B^size
+bool NaturalNumber::submulAbs(const NaturalNumber &a, const NaturalNumber &b) {
+    if (!a.isNotEqualZero() || !b.isNotEqualZero())
+        return false;
+    if (&a == this || &b == this || this->decimalScale != 0 || a.decimalScale != 0 || b.decimalScale != 0) {
+        NaturalNumber product = a.multiply(b);
+        if (this->cmp(&product) == 1) {
+            product.subInPlace(*this);
+            *this = std::move(product);
+            return true;
         }
-        res[i] = static_cast<uint8_t>(diff);
+        this->subInPlace(product);
+        return false;
+    }
+
+    const std::size_t an = a.mantissa().size();
+    const std::size_t bn = b.mantissa().size();
+    const std::size_t size = std::max(this->limbs.size(), an + bn);
+    this->limbs.resize(size, 0);
+    Limb *r = this->limbs.data();
+    const bool negative = accumulateProduct(r, size, a.mantissa().data(), an, b.mantissa().data(), bn, true) != 0;
+    if (negative) {
+        for (std::size_t i = 0; i < size; ++i)
+            r[i] = ~r[i];
+        LimbArithmetic::add1(r, r, size, 1);
     }
-    return NaturalNumber(res);
+    this->normalize();
+    return negative;
 }
 
 // N6: Умножение на одну цифру (0–9).
@@ -246,78 +538,104 @@ NaturalNumber NaturalNumber::multiplyByDigit(std::size_t b) const {
         std::string msg = "NaturalNumber::MUL_ND_N: digit out of range (" + std::to_string(b) + ")";
         throw UniversalStringException(msg);
     }
-    if (b == 0) return NaturalNumber(std::vector<uint8_t>{0});
-    std::vector<uint8_t> res;
-    res.reserve(this->numbers.size() + 1);
-    unsigned int carry = 0;
-    for (size_t i = 0; i < this->numbers.size(); ++i) {
-        unsigned int prod = static_cast<unsigned int>(this->numbers[i]) * b + carry;
-        res.push_back(static_cast<uint8_t>(prod % 10));
-        carry = prod / 10;
-    }
-    while (carry > 0) {
-        res.push_back(static_cast<uint8_t>(carry % 10));
-        carry /= 10;
+    if (b == 0 || !this->isNotEqualZero()) return NaturalNumber();
+    NaturalNumber result;
+    result.limbs.reserve(this->mantissa().size() + 1);
+    result.limbs.assign(this->mantissa().data(), this->mantissa().size());
+    result.decimalScale = this->decimalScale;
+    result.mulSmallInPlace(b);
+    return result;
+}
+
+NaturalNumber &NaturalNumber::mulSmallInPlace(Limb factor) {
+    if (factor == 0) {
+        this->limbs.clear();
+        this->decimalScale = 0;
+        return *this;
     }
-    return NaturalNumber(res);
+    Limb carry = LimbArithmetic::mul1(this->limbs.data(), this->limbs.data(), this->limbs.size(), factor);
+    if (carry) this->limbs.push_back(carry);
+    return *this;
 }
 
-//  N7: Умножение на 10^k (сдвиг влево на k позиций).
+//  N7: Умножение на 10^k.
 NaturalNumber NaturalNumber::multiplyByPowerOfTen(std::size_t k) const {
-    // Если число равно 0
+    NaturalNumber result(*this);
+    result.shiftInPlace(k);
+    return result;
+}
 
+// Сдвиг только копит показатель, слова не меняются
+NaturalNumber &NaturalNumber::shiftInPlace(std::size_t k) {
+    // Если число равно 0
     if (!this->isNotEqualZero())
-        return NaturalNumber(std::vector<uint8_t>{0});
+        return *this;
 
-    if (this->numbers.size() + k >= SIZE_MAX){
-        throw UniversalStringException("The size of number is greater then " + std::to_string(SIZE_MAX));
-    }
-
-    std::vector<uint8_t> res;
-    try{
-         res.reserve(this->numbers.size() + k);
-    }catch (const std::bad_alloc& e) {
-        throw UniversalStringException("Not enough memory to multiply by power of ten");
-    }
-    // Добавляем k нулей в начало (сдвигаем)
-    res.insert(res.cend(), k, 0);
-    // Добавляем все цифры исходного числа
-    res.insert(res.cend(), this->numbers.begin(), this->numbers.end());
-    return NaturalNumber(res);
+    this->decimalScale = addScales(this->decimalScale, k);
+    return *this;
 }
 
-//  N8: Умножение двух натуральных чисел (в столбик).
+//  N8: Умножение двух натуральных чисел (в столбик, Карацубой или Тоом-3 в зависимости от длины).
 NaturalNumber NaturalNumber::multiply(const NaturalNumber &other) const {
     // Если одно из чисел = 0 → результат = 0
-    if ((this->numbers.size() == 1 && this->numbers[0] == 0) ||
-        (other.numbers.size() == 1 && other.numbers[0] == 0)) {
-        return NaturalNumber(std::vector<uint8_t>{0});
-    }
-
-    std::vector<uint8_t> res(this->numbers.size() + other.numbers.size(), 0);
-
-    for (size_t i = 0; i < numbers.size(); ++i) {
-        uint8_t carry = 0;
-        for (size_t j = 0; j < other.numbers.size() || carry; ++j) {
-            unsigned long long cur = res[i + j] +
-                                     static_cast<unsigned long long>(numbers[i]) *
-                                     (j < other.numbers.size() ? other.numbers[j] : 0) +
-                                     carry;
-            res[i + j] = static_cast<uint8_t>(cur % 10);
-            carry = static_cast<uint8_t>(cur / 10);
-        }
+    if (!this->isNotEqualZero() || !other.isNotEqualZero()) {
+        return NaturalNumber();
     }
+    if (this == &other)
+        return this->square();
+
+    // Множители 10^k перемножаются сложением показателей
+    const LimbStorage &longer = this->mantissa().size() >= other.mantissa().size() ? this->mantissa() : other.mantissa();
+    const LimbStorage &shorter = this->mantissa().size() >= other.mantissa().size() ? other.mantissa() : this->mantissa();
+
+    NaturalNumber result;
+    result.decimalScale = addScales(this->decimalScale, other.decimalScale);
+    result.limbs.resize(longer.size() + shorter.size());
+    Multiplication::multiply(result.limbs.data(), longer.data(), longer.size(), shorter.data(), shorter.size());
 
     // Удаляем ведущие нули
-    while (res.size() > 1 && res.back() == 0)
-        res.pop_back();
+    result.normalize();
+    return result;
+}
 
-    return NaturalNumber(res);
+// Квадрат требует примерно вдвое меньше умножений слов, чем произведение разных чисел той же длины
+NaturalNumber NaturalNumber::square() const {
+    if (!this->isNotEqualZero())
+        return NaturalNumber();
+
+    NaturalNumber result;
+    result.limbs.resize(2 * this->mantissa().size());
+    result.decimalScale = addScales(this->decimalScale, this->decimalScale);
+    Multiplication::square(result.limbs.data(), this->mantissa().data(), this->mantissa().size());
+    result.normalize();
+    return result;
+}
+
+NaturalNumber &NaturalNumber::operator*=(const NaturalNumber &other) {
+    // Множитель из одного слова умножаем на месте, иначе произведению нужен отдельный буфер
+    if (other.mantissa().size() == 1) {
+        const std::size_t scale = other.decimalScale;
+        this->mulSmallInPlace(other.mantissa()[0]);
+        return this->shiftInPlace(scale);
+    }
+    *this = this->multiply(other);
+    return *this;
+}
+
+NaturalNumber NaturalNumber::fromDoubleLimb(DoubleLimb value) {
+    NaturalNumber result;
+    const Limb low = static_cast<Limb>(value);
+    const Limb high = static_cast<Limb>(value >> LimbArithmetic::LIMB_BITS);
+    if (low != 0 || high != 0)
+        result.limbs.push_back(low);
+    if (high != 0)
+        result.limbs.push_back(high);
+    return result;
 }
 
 //N2: Проверка на ноль: если число не равно нулю, то «да» иначе «нет»
 bool NaturalNumber::isNotEqualZero() const {
-    return !(numbers.size() == 1 && numbers[0] == 0);
+    return !this->mantissa().empty();
 }
 
 // N9: Вычитание из первого числа меньшего числа, умноженного на цифру.
@@ -343,17 +661,21 @@ NaturalNumber NaturalNumber::getFirstDivisionDigit(const NaturalNumber& other) c
     if (cmp(&other) == 1)
         throw UniversalStringException("NaturalNumber::getFirstDivisionDigit: The divisor is greater than the divisible");
 
-    std::size_t k = numbers.size() - other.getNumbers().size();
+    std::size_t k = this->decimalDigitCount() - other.decimalDigitCount();
     NaturalNumber temp = other.multiplyByPowerOfTen(k);
 
     while (k > 0 && cmp(&temp) == 1) {
         --k;
-        temp = other.multiplyByPowerOfTen(k);
+        temp = other;
+        temp.shiftInPlace(k);
     }
 
+    // Кандидаты d * temp строятся в одном буфере
     std::size_t digit = 0;
+    NaturalNumber multiplied;
     for (int d = 9; d >= 1; --d) {
-        NaturalNumber multiplied = temp.multiplyByDigit(static_cast<std::size_t>(d));
+        multiplied = temp;
+        multiplied.mulSmallInPlace(static_cast<Limb>(d));
 
         if (cmp(&multiplied) != 1) {
             digit = static_cast<std::size_t>(d);
@@ -9,34 +9,47 @@
 #include <cstdint>
 #include <string>
 #include <iostream>
+#include "Arithmetic/LimbStorage.h"
 
+// Число хранится в системе счисления с основанием 2^64: limbs[0] - младшее слово.
+// Старших нулевых слов нет, ноль представлен пустым массивом. Числа до двух слов хранятся без выделения памяти.
+// Умножение на 10^k не трогает слова, а копит k в decimalScale: значение равно limbs * 10^decimalScale.
+// Сравнение, сложение, вычитание, умножение, деление и вывод учитывают множитель сами, остальные операции
+// работают с временной копией без множителя (digits), поэтому числа вроде 10^100000 не разворачиваются в памяти.
 class NaturalNumber {
 public:
+    struct DivisionResult; //частное и остаток одного деления
 
+    NaturalNumber() = default; //ноль
     explicit NaturalNumber(const std::vector<uint8_t> &CpNumbers);
     NaturalNumber(unsigned long long a); //решение для облегченного тестирования, потом будет выпелено
     NaturalNumber(const std::string& a); //основной конструктор
 
-    NaturalNumber(const NaturalNumber& other) : numbers(other.numbers) {}
-    NaturalNumber(NaturalNumber&& other) noexcept : numbers(std::move(other.numbers)) {
-        other.numbers = {0};
+    NaturalNumber(const NaturalNumber& other) : limbs(other.mantissa()), decimalScale(other.decimalScale) {}
+    NaturalNumber(NaturalNumber&& other) noexcept : limbs(std::move(other.limbs)), decimalScale(other.decimalScale) {
+        other.limbs.clear();
+        other.decimalScale = 0;
     }
 
     NaturalNumber& operator=(const NaturalNumber& other) {
         if (this != &other) {
-            numbers = other.numbers;
+            limbs = other.mantissa();
+            decimalScale = other.decimalScale;
         }
         return *this;
     }
     NaturalNumber& operator=(NaturalNumber&& other) noexcept {
         if (this != &other) {
-            numbers = std::move(other.numbers);
+            limbs = std::move(other.limbs);
+            decimalScale = other.decimalScale;
+            other.limbs.clear();
+            other.decimalScale = 0;
         }
         return *this;
     }
 
-    std::string toString();
-    const std::vector<uint8_t>& getNumbers() const noexcept;
+    std::string toString() const;
+    std::vector<uint8_t> getNumbers() const; //десятичные цифры от младшей к старшей, строятся при каждом вызове
     uint8_t cmp(const NaturalNumber* other) const;
     bool isNotEqualZero() const;
     void increment();
@@ -44,17 +57,73 @@ public:
     NaturalNumber subtract(const NaturalNumber& other) const;
     NaturalNumber multiplyByDigit(std::size_t b) const;
     NaturalNumber multiplyByPowerOfTen(std::size_t k) const;
-    NaturalNumber multiply(const NaturalNumber& other) const;
+    NaturalNumber multiply(const NaturalNumber& other) const; //для other == *this считает квадрат
+    NaturalNumber square() const;
+
+    // Изменяющие варианты операций: результат пишется в текущее число, его память переиспользуется
+    NaturalNumber& addInPlace(const NaturalNumber& other);
+    NaturalNumber& subInPlace(const NaturalNumber& other); //вычитаемое не больше текущего числа
+    NaturalNumber& mulSmallInPlace(Limb factor); //умножение на одно слово
+    NaturalNumber& shiftInPlace(std::size_t k); //умножение на 10^k
+    NaturalNumber& operator+=(const NaturalNumber& other) { return this->addInPlace(other); }
+    NaturalNumber& operator-=(const NaturalNumber& other) { return this->subInPlace(other); }
+    NaturalNumber& operator*=(const NaturalNumber& other);
+    NaturalNumber& addmul(const NaturalNumber& a, const NaturalNumber& b); //this += a * b
+    NaturalNumber& submul(const NaturalNumber& a, const NaturalNumber& b); //this -= a * b, произведение не больше текущего числа
+    bool submulAbs(const NaturalNumber& a, const NaturalNumber& b); //this = |this - a * b|, true - если a * b было больше
+
     NaturalNumber subtractMultiplied(const NaturalNumber& other, std::size_t c) const;
     NaturalNumber getFirstDivisionDigit(const NaturalNumber& other) const;
+    DivisionResult divmod(const NaturalNumber& other) const;
     NaturalNumber quotient(const NaturalNumber& other) const;
     NaturalNumber remainder(const NaturalNumber& other) const;
     NaturalNumber GCD(const NaturalNumber& other) const;
     NaturalNumber LCM(const NaturalNumber& other) const;
+    NaturalNumber pow(const NaturalNumber& exponent) const; //0^0 = 1
+    NaturalNumber modPow(const NaturalNumber& exponent, const NaturalNumber& modulus) const; //модуль отличен от нуля
+    NaturalNumber isqrt() const; //целая часть квадратного корня
+    NaturalNumber iroot(std::size_t k) const; //целая часть корня степени k > 0
+    bool isPerfectPower() const; //представимо ли в виде y^k при k >= 2
+
+    // Пакетные операции над многими числами по дереву произведений, см. ProductTree
+    static NaturalNumber productOf(const std::vector<NaturalNumber>& values); //пустой набор - 1
+    static NaturalNumber lcmOf(const std::vector<NaturalNumber>& values); //все числа ненулевые, пустой набор - 1
+    static NaturalNumber gcdOf(const std::vector<NaturalNumber>& values); //хотя бы одно ненулевое, останавливается на 1
+    std::vector<NaturalNumber> remainders(const std::vector<NaturalNumber>& moduli) const; //остатки по всем модулям
+
+    // Комбинаторные числа через разложение на простые, см. Combinatorics; n < 2^32
+    static NaturalNumber factorial(std::size_t n);
+    static NaturalNumber binomial(std::size_t n, std::size_t k); //при k > n - ноль
+    static NaturalNumber primorial(std::size_t n); //произведение простых p <= n
+
+    // Быстрые пути IntegerNumber и RationalNumber для чисел в одно слово: такие числа не выделяют памяти,
+    // и операции над ними можно считать в машинных словах с проверкой переполнения
+    bool toLimb(Limb& value) const noexcept {
+        if (this->decimalScale != 0 || this->mantissa().size() > 1)
+            return false;
+        value = this->mantissa().empty() ? 0 : this->mantissa()[0];
+        return true;
+    }
+    static NaturalNumber fromDoubleLimb(DoubleLimb value);
 
 
 private:
-    std::vector<uint8_t> numbers;
+    LimbStorage limbs;
+    std::size_t decimalScale = 0; //у нуля всегда 0
+
+    // Константный доступ к словам: неконстантный data() копировал бы разделяемый буфер
+    const LimbStorage& mantissa() const noexcept { return limbs; }
+    std::vector<Limb> digits() const; //слова значения без отложенного множителя
+    NaturalNumber withScale(std::size_t scale) const; //то же значение с decimalScale == scale <= this->decimalScale
+    void normalize();
+    std::size_t bitLength() const;
+    std::size_t decimalDigitCount() const;
+    static Limb powerOfTen(unsigned k);
+};
+
+struct NaturalNumber::DivisionResult {
+    NaturalNumber quotient;
+    NaturalNumber remainder;
 };
 
 
@@ -6,6 +6,33 @@
 #include "Exceptions/UniversalStringException.h"
 #include <algorithm>
 
+namespace {
+    // Коэффициенты a_i / d_i как целые числа над общим знаменателем: a_i / d_i = A_i / D, D - НОК всех d_i
+    std::vector<IntegerNumber> overCommonDenominator(const std::vector<RationalNumber> &coefficients,
+                                                     NaturalNumber &denominator) {
+        std::vector<NaturalNumber> denominators;
+        denominators.reserve(coefficients.size());
+        for (const RationalNumber &coefficient : coefficients)
+            denominators.push_back(coefficient.getNaturalDenominator());
+        denominator = NaturalNumber::lcmOf(denominators);
+
+        std::vector<IntegerNumber> result;
+        result.reserve(coefficients.size());
+        for (const RationalNumber &coefficient : coefficients) {
+            result.push_back(coefficient.getIntegerNumerator());
+            result.back() *= IntegerNumber(denominator.quotient(coefficient.getNaturalDenominator()), false);
+        }
+        return result;
+    }
+
+    // Дробь A / D, ноль - как 0/1
+    RationalNumber fraction(const IntegerNumber &numerator, const NaturalNumber &denominator) {
+        if (numerator.getSign() == 0)
+            return RationalNumber(IntegerNumber(NaturalNumber(), false), NaturalNumber(1));
+        return RationalNumber(numerator, denominator);
+    }
+}
+
 
 const std::vector<RationalNumber>& Polynomial::getCoefficients() noexcept {
     return this->coefficients;
@@ -20,7 +47,7 @@ std::string Polynomial::toString() const{
     for (int i = this->coefficients.size() - 1; i >= 0; --i) {
 
         std::string coeff;
-        if (this->coefficients.at(i).getIntegerNumerator().abs().isNotEqualZero() || (i == 0 && this->coefficients.size() == 1)){
+        if (this->coefficients.at(i).getIntegerNumerator().magnitude().isNotEqualZero() || (i == 0 && this->coefficients.size() == 1)){
             if (this->coefficients.at(i).getNaturalDenominator().cmp(&one) == 0){
                 coeff = this->coefficients.at(i).getIntegerNumerator().toString();
             }else{
@@ -74,12 +101,7 @@ Polynomial::Polynomial(const std::vector<rationalSupport> &coefficientsA) {
 
 //P10: Остаток от деления полиномов
 Polynomial Polynomial::remainder(const Polynomial &other) const {
-    // Находим неполное частное от деления
-    Polynomial incomplete_quotient = this->quotient(other);
-    // Умножаем неполное частное на делитель
-    Polynomial product = incomplete_quotient.multiply(other);
-    // Вычитаем из исходного полинома произведение, получаем остаток от деления
-    return this->subtract(product);
+    return this->divmod(other).remainder;
 }
 
 //P11: НОД полиномов
@@ -119,7 +141,7 @@ Polynomial Polynomial::GCD(const Polynomial &other) const {
     // сделаем многочлен приведенным (старший коэффициент 1)
     // Для этого нужно поделить на старший коэффицинет или умножить на обратный к нему
     RationalNumber highest_coeff = polynom2->coefficients[polynom2->getDegree()];
-    RationalNumber unit = RationalNumber(IntegerNumber({1}, false), NaturalNumber({1}));
+    RationalNumber unit = RationalNumber(IntegerNumber(std::vector<uint8_t>{1}, false), NaturalNumber({1}));
     RationalNumber anti_highest_coeff = unit.division(highest_coeff);
 
     gcd = gcd.multiplyByRational(anti_highest_coeff);
@@ -138,7 +160,7 @@ Polynomial Polynomial::derivative() const {
     // Если степень 0, значит, полином представляет обой константу,
     // следоватеьно, производная равна 0, особый случай, обрабатываетя отдельно
     if(this->getDegree() == 0){
-        return Polynomial({RationalNumber(IntegerNumber({0}, false), NaturalNumber{1})});
+        return Polynomial({RationalNumber(IntegerNumber(std::vector<uint8_t>{0}, false), NaturalNumber{1})});
     }
 
     // Иначе создаем новый объект для хранения производной
@@ -176,15 +198,19 @@ Polynomial Polynomial::makeSquareFree() const {
 
 //P7: Вынесение из многочлена НОК знаменателей коэффициентов и НОД числителей
 Polynomial Polynomial::factorOut() const {
-    NaturalNumber nod = coefficients.at(0).getIntegerNumerator().abs(); //предположили, что первые числа будут НОД и НОК
-    NaturalNumber nok = coefficients.at(0).getNaturalDenominator();
-
-    for(size_t i = 1; i < coefficients.size(); i++){
-        nod = nod.GCD(coefficients.at(i).getIntegerNumerator().abs()); //находим НОД из последовательного алгоритма Евклида для всех коэффициентов
-        nok = nok.LCM(coefficients.at(i).getNaturalDenominator()); //пользуемся формулой связи НОД и НОК последовательно для всех коэффициентов
+    std::vector<NaturalNumber> numerators;
+    std::vector<NaturalNumber> denominators;
+    numerators.reserve(coefficients.size());
+    denominators.reserve(coefficients.size());
+    for (const RationalNumber &coefficient : coefficients) {
+        numerators.push_back(coefficient.getIntegerNumerator().abs());
+        denominators.push_back(coefficient.getNaturalDenominator());
     }
 
-    return this->multiplyByRational(RationalNumber(IntegerNumber(nok.getNumbers(), false), nod)); //получившийся полином = НОК/НОД * исходный полином
+    NaturalNumber nod = NaturalNumber::gcdOf(numerators); //НОД числителей, свёртка останавливается на 1
+    NaturalNumber nok = NaturalNumber::lcmOf(denominators); //НОК знаменателей по дереву произведений
+
+    return this->multiplyByRational(RationalNumber(IntegerNumber(nok, false), nod)); //получившийся полином = НОК/НОД * исходный полином
 }
 
 //P8: Умножение многочленов
@@ -195,91 +221,140 @@ Polynomial Polynomial::multiply(const Polynomial &other) const {
     );
 
     // Проверка на нулевой полином (всё коэффициенты = 0)
-    bool thisZero = this->coefficients.size() == 1 && !this->coefficients.at(0).getIntegerNumerator().abs().isNotEqualZero();
-    bool otherZero = other.coefficients.size() == 1 && !other.coefficients.at(0).getIntegerNumerator().abs().isNotEqualZero();
+    bool thisZero = this->coefficients.size() == 1 && !this->coefficients.at(0).getIntegerNumerator().magnitude().isNotEqualZero();
+    bool otherZero = other.coefficients.size() == 1 && !other.coefficients.at(0).getIntegerNumerator().magnitude().isNotEqualZero();
     if (thisZero || otherZero) return Polynomial({zero});
 
     size_t n = this->coefficients.size();
     size_t m = other.coefficients.size();
 
-    // Резервируем результат и инициализируем нулями — один объект RationalNumber на слот
+    // Многочлены приводятся к целым коэффициентам над общими знаменателями: свёртка идёт целочисленным
+    // addmul без промежуточных дробей, а знаменатель произведения - произведение двух знаменателей
+    NaturalNumber thisDenominator, otherDenominator;
+    const std::vector<IntegerNumber> a = overCommonDenominator(this->coefficients, thisDenominator);
+    const std::vector<IntegerNumber> b = overCommonDenominator(other.coefficients, otherDenominator);
+
+    // Резервируем результат и инициализируем нулями
+    std::vector<IntegerNumber> sums;
     std::vector<RationalNumber> resultCoeffs;
     try {
-        resultCoeffs.assign(n + m - 1, zero);
+        sums.assign(n + m - 1, IntegerNumber(NaturalNumber(), false));
+        resultCoeffs.reserve(n + m - 1);
     }catch (const std::bad_alloc& e) {
         throw UniversalStringException("Not enough memory to multiply by power of ten");
     }
 
     // Классическое O(n*m) умножение
     for (size_t i = 0; i < n; ++i) {
-        const RationalNumber &ai = this->coefficients[i];
-        // если ai == 0 — пропускаем
-        if (!ai.getIntegerNumerator().abs().isNotEqualZero()) continue;
+        // если a_i == 0 — пропускаем
+        if (a[i].getSign() == 0) continue;
 
         for (size_t j = 0; j < m; ++j) {
-            const RationalNumber &bj = other.coefficients[j];
-            if (!bj.getIntegerNumerator().abs().isNotEqualZero()) continue;
-            RationalNumber prod = ai.multiply(bj);
-            resultCoeffs[i + j] = resultCoeffs[i + j].add(prod);
+            sums[i + j].addmul(a[i], b[j]);
         }
     }
 
+    const NaturalNumber denominator = thisDenominator.multiply(otherDenominator);
+    for (const IntegerNumber &sum : sums) {
+        resultCoeffs.push_back(fraction(sum, denominator));
+        resultCoeffs.back().reduce();
+    }
+
     return Polynomial(resultCoeffs);
 }
 
-//P9: Частное от деления многочлена на многочлен при делении с остатком
-Polynomial Polynomial::quotient(const Polynomial &other) const {
+// Деление "в столбик": после вычитаний в рабочем массиве остаётся остаток,
+// поэтому частное не приходится умножать обратно на делитель
+Polynomial::DivisionResult Polynomial::divmod(const Polynomial &other) const {
     const std::vector<RationalNumber>& divisorCoeffs = other.coefficients;
 
     RationalNumber zero(IntegerNumber(std::vector<uint8_t>{0}, false), NaturalNumber(std::vector<uint8_t>{1}));
 
     // Проверка деления на ноль
-    if (!divisorCoeffs.back().getIntegerNumerator().abs().isNotEqualZero()) {
+    if (!divisorCoeffs.back().getIntegerNumerator().magnitude().isNotEqualZero()) {
         throw UniversalStringException("you cannot divide by zero");
     }
 
     size_t divisorSize = divisorCoeffs.size();
     size_t dividendSize = coefficients.size();
 
-    // Если делимое меньше делителя — частное = 0
-    if (dividendSize < divisorSize) {
-        return Polynomial({zero});
-    }
-
-    // Работаем с копией делимого напрямую (избегаем создания Polynomial)
-    std::vector<RationalNumber> remainder = coefficients;
-    std::vector<RationalNumber> quotientCoeffs(dividendSize - divisorSize + 1, zero);
+    // Делимое и делитель приводятся к целым коэффициентам над общими знаменателями Dr и Db,
+    // и вычитание строки делителя идёт целочисленным submul без промежуточных дробей
+    NaturalNumber divisorDenominator, restDenominator;
+    const std::vector<IntegerNumber> divisor = overCommonDenominator(divisorCoeffs, divisorDenominator);
+    std::vector<IntegerNumber> rest = overCommonDenominator(coefficients, restDenominator);
+    std::vector<RationalNumber> quotientCoeffs(dividendSize >= divisorSize ? dividendSize - divisorSize + 1 : 1, zero);
 
-    const RationalNumber& divisorLeading = divisorCoeffs.back();
+    const IntegerNumber& divisorLeading = divisor.back();
+    const NaturalNumber one(1);
 
-    // Основной цикл деления "в столбик"
-    for (size_t pos = dividendSize; pos >= divisorSize; --pos) {
+    // Основной цикл деления "в столбик"; если делимое меньше делителя, частное = 0
+    for (size_t pos = dividendSize; pos >= divisorSize && dividendSize >= divisorSize; --pos) {
         size_t quotientIdx = pos - divisorSize;
 
         // Проверяем, не нулевой ли старший коэффициент остатка
-        if (!remainder[pos - 1].getIntegerNumerator().abs().isNotEqualZero()) {
+        const IntegerNumber& leading = rest[pos - 1];
+        if (leading.getSign() == 0) {
             continue;
         }
 
-        // Вычисляем коэффициент частного
-        RationalNumber coeff = remainder[pos - 1].division(divisorLeading);
+        // Отношение старших коэффициентов R / B после сокращения - t / s при s > 0.
+        // Остаток R_k / Dr заменяется на (s * R_k - t * B_k) / (s * Dr): старший член гасится, значение то же
+        const NaturalNumber common = leading.magnitude().GCD(divisorLeading.magnitude());
+        const IntegerNumber t(leading.magnitude().quotient(common), leading.getSign() != divisorLeading.getSign());
+        const NaturalNumber s = divisorLeading.magnitude().quotient(common);
+
+        // Вычисляем коэффициент частного: (R / Dr) / (B / Db) = t * Db / (s * Dr)
+        RationalNumber coeff(t.multiply(IntegerNumber(divisorDenominator, false)), s.multiply(restDenominator));
+        coeff.reduce();
         quotientCoeffs[quotientIdx] = coeff;
 
-        // Вычитаем (делитель * coeff) из остатка IN-PLACE
-        // Избегаем создания временных Polynomial объектов
+        if (s.cmp(&one) != 0) {
+            const IntegerNumber scale(s, false);
+            for (size_t k = 0; k < pos; ++k) {
+                rest[k] *= scale;
+            }
+            restDenominator *= s;
+        }
+
+        // Вычитаем (делитель * t) из остатка IN-PLACE, произведения копятся прямо в коэффициентах
         for (size_t j = 0; j < divisorSize; ++j) {
-            RationalNumber product = divisorCoeffs[j].multiply(coeff);
-            remainder[quotientIdx + j] = remainder[quotientIdx + j].subtract(product);
+            rest[quotientIdx + j].submul(t, divisor[j]);
         }
     }
 
+    std::vector<RationalNumber> remainder;
+    remainder.reserve(rest.size());
+    for (const IntegerNumber &coefficient : rest) {
+        remainder.push_back(fraction(coefficient, restDenominator));
+    }
+
     // Удаляем ведущие нули один раз в конце
     while (quotientCoeffs.size() > 1 &&
-           !quotientCoeffs.back().getIntegerNumerator().abs().isNotEqualZero()) {
+           !quotientCoeffs.back().getIntegerNumerator().magnitude().isNotEqualZero()) {
         quotientCoeffs.pop_back();
     }
 
-    return Polynomial(quotientCoeffs);
+    // Степень остатка меньше степени делителя: старшие коэффициенты обнулены вычитаниями
+    // (при делении на константу остаётся обнулённый свободный член)
+    if (remainder.size() >= divisorSize)
+        remainder.resize(std::max<size_t>(divisorSize - 1, 1), zero);
+    // Остаток приводим к тому же виду, что и результат add: без ведущих нулей, с сокращёнными коэффициентами
+    while (remainder.size() > 1 && !remainder.back().getIntegerNumerator().magnitude().isNotEqualZero()) {
+        remainder.pop_back();
+    }
+    for (auto & remainderCoeff : remainder) {
+        if (remainderCoeff.getIntegerNumerator().magnitude().isNotEqualZero()){
+            remainderCoeff.reduce();
+        }
+    }
+
+    return {Polynomial(quotientCoeffs), Polynomial(remainder)};
+}
+
+//P9: Частное от деления многочлена на многочлен при делении с остатком
+Polynomial Polynomial::quotient(const Polynomial &other) const {
+    return this->divmod(other).quotient;
 }
 
 
@@ -304,7 +379,7 @@ Polynomial Polynomial::add(const Polynomial &other) const {
     }
 
     for (size_t i = resultCoeffs.size() - 1; i >= 1; --i) {
-        if (!resultCoeffs.at(i).getIntegerNumerator().abs().isNotEqualZero())
+        if (!resultCoeffs.at(i).getIntegerNumerator().magnitude().isNotEqualZero())
             resultCoeffs.pop_back(); //примнение pop_back корректно, тк мы имеем право удалять только ведущие нули, если коэффицент при наибольшей степени не 0, то даже не рассматриваем оставшиеся
             //также последний элемент веткора даже при равенстве нулю не убираем, тк пустой вектор коээфициентов для полинома не корректен
         else
@@ -312,7 +387,7 @@ Polynomial Polynomial::add(const Polynomial &other) const {
     }
 
     for (auto & resultCoeff : resultCoeffs) {
-        if (resultCoeff.getIntegerNumerator().abs().isNotEqualZero()){
+        if (resultCoeff.getIntegerNumerator().magnitude().isNotEqualZero()){
             resultCoeff.reduce();
         }
     }
@@ -334,7 +409,7 @@ Polynomial Polynomial::subtract(const Polynomial &other) const {
 
 //P3: Умножение многочлена на рациональное число
 Polynomial Polynomial::multiplyByRational(const RationalNumber &b) const {
-    if (!b.getIntegerNumerator().abs().isNotEqualZero()){
+    if (!b.getIntegerNumerator().magnitude().isNotEqualZero()){
         return Polynomial(std::vector<RationalNumber>{RationalNumber(IntegerNumber(std::vector<uint8_t>{0}, false), NaturalNumber(std::vector<uint8_t>{1}))});
     }
     std::vector<RationalNumber> result;
@@ -360,7 +435,7 @@ Polynomial Polynomial::multiplyByXInKPower(std::size_t k) const {
         throw UniversalStringException("Not enough memory to multiply by power of ten");
     }
 
-    RationalNumber zero(IntegerNumber({0}, false), NaturalNumber(std::vector<uint8_t>{1}));
+    RationalNumber zero(IntegerNumber(std::vector<uint8_t>{0}, false), NaturalNumber(std::vector<uint8_t>{1}));
     //Добавляем в конец полинома количество нулей, равное k
     for (size_t i = 0; i < k; i++) {
         result.push_back(zero);
@@ -11,6 +11,8 @@
 
 class Polynomial {
 public:
+    struct DivisionResult; //частное и остаток одного деления
+
     struct rationalSupport{
         long long numerator, denominator;
     };
@@ -47,6 +49,7 @@ public:
     std::size_t getDegree() const;
     Polynomial factorOut() const;
     Polynomial multiply(const Polynomial& other) const;
+    DivisionResult divmod(const Polynomial& other) const;
     Polynomial quotient(const Polynomial& other) const;
     Polynomial remainder(const Polynomial& other) const;
     Polynomial GCD(const Polynomial& other) const;
@@ -57,5 +60,10 @@ private:
     std::vector<RationalNumber> coefficients;
 };
 
+struct Polynomial::DivisionResult {
+    Polynomial quotient;
+    Polynomial remainder;
+};
+
 
 #endif //DMATGCOLLOQUIUM_POLYNOMIAL_H
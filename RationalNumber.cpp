@@ -4,71 +4,103 @@
 
 #include "RationalNumber.h"
 #include "Exceptions/UniversalStringException.h"
-
-RationalNumber::RationalNumber(long long numeratorA, long long denominatorA) {
-    this->numerator = new IntegerNumber(numeratorA);
-    this->denominator = new NaturalNumber(denominatorA);
+#include "Arithmetic/LimbAllocator.h"
+#include <numeric>
+
+namespace {
+    // Сумма x + y (или x - y) для дробей из чисел в одно слово в машинной арифметике. Результат тот же,
+    // что в общем пути: знаменатель - НОК знаменателей, числители домножаются на дополнительные множители.
+    // false, если НОК или домноженный числитель не помещается в слово - тогда считается длинной арифметикой
+    bool addSmall(const RationalNumber &x, const RationalNumber &y, bool subtract,
+                  IntegerNumber &numerator, Limb &denominator) {
+        Limb a, b, c, d;
+        if (!x.getIntegerNumerator().magnitude().toLimb(a) || !x.getNaturalDenominator().toLimb(b) ||
+            !y.getIntegerNumerator().magnitude().toLimb(c) || !y.getNaturalDenominator().toLimb(d) || b == 0 || d == 0)
+            return false;
+        const Limb g = std::gcd(b, d);
+        Limb lcm, scaledA, scaledC;
+        if (__builtin_mul_overflow(b / g, d, &lcm) || __builtin_mul_overflow(a, lcm / b, &scaledA) ||
+            __builtin_mul_overflow(c, lcm / d, &scaledC))
+            return false;
+        numerator = IntegerNumber(NaturalNumber(scaledA), x.getIntegerNumerator().isNegative());
+        const IntegerNumber term(NaturalNumber(scaledC), y.getIntegerNumerator().isNegative());
+        if (subtract)
+            numerator -= term;
+        else
+            numerator += term;
+        denominator = lcm;
+        return true;
+    }
 }
 
-RationalNumber::RationalNumber(const std::string &numeratorA, const std::string &denominatorA) {
-    this->numerator = new IntegerNumber(numeratorA);
-    this->denominator = new NaturalNumber(denominatorA);
-}
+RationalNumber::RationalNumber(long long numeratorA, long long denominatorA)
+        : numerator(numeratorA), denominator(denominatorA) {}
+
+RationalNumber::RationalNumber(const std::string &numeratorA, const std::string &denominatorA)
+        : numerator(numeratorA), denominator(denominatorA) {}
 
 std::string RationalNumber::toString() const {
     this->reduce();
-    return this->numerator->toString() + "/" + this->denominator->toString();
+    return this->numerator.toString() + "/" + this->denominator.toString();
 }
 
 const IntegerNumber &RationalNumber::getIntegerNumerator() const noexcept {
-    return *this->numerator;
+    return this->numerator;
 }
 
 const NaturalNumber &RationalNumber::getNaturalDenominator() const noexcept {
-    return *this->denominator;
+    return this->denominator;
 }
 
-RationalNumber::RationalNumber(const std::string &s) {
+RationalNumber::RationalNumber(const std::string &s) : numerator(0LL), denominator(1) {
     size_t delimiterPos = s.find('/');
     if (delimiterPos == std::string::npos) {
-        this->numerator = new IntegerNumber(s);
-        this->denominator = new NaturalNumber(std::vector<uint8_t>{1});
+        this->numerator = IntegerNumber(s);
     } else {
         std::string numeratorS = s.substr(0, delimiterPos);
         std::string denominatorS = s.substr(delimiterPos + 1);
-        this->numerator = new IntegerNumber(numeratorS);
-        this->denominator = new NaturalNumber(denominatorS);
+        this->numerator = IntegerNumber(numeratorS);
+        this->denominator = NaturalNumber(denominatorS);
     }
 }
 
 // Q1: сокращение дроби.
 void RationalNumber::reduce() const{
+    // Числитель и знаменатель в одно слово сокращаются в машинной арифметике
+    Limb numeratorLimb, denominatorLimb;
+    if (this->numerator.magnitude().toLimb(numeratorLimb) && this->denominator.toLimb(denominatorLimb) &&
+        denominatorLimb != 0) {
+        const Limb gcd = std::gcd(numeratorLimb, denominatorLimb);
+        if (gcd != 1) {
+            this->numerator = IntegerNumber(NaturalNumber(numeratorLimb / gcd), this->numerator.getSign() == 1);
+            this->denominator = NaturalNumber(denominatorLimb / gcd);
+        }
+        return;
+    }
+
+    // Сокращение подменяет буферы числа, которое могло быть создано вне текущей арены,
+    // поэтому новые буферы берутся из пула, а не из арены
+    LimbPoolScope poolScope;
+
     // Беру модуль числителя, чтобы поиск НОД не вызвал проблем.
     // Далее ищу НОД.
-    NaturalNumber numeratorAbs = this->numerator->abs();
-    NaturalNumber gcd = numeratorAbs.GCD(*this->denominator);
+    NaturalNumber gcd = this->numerator.magnitude().GCD(this->denominator);
 
     // Если НОД равен 1, то это финиш (некуда сокращать).
-    const std::vector<uint8_t> &gcdDigits = gcd.getNumbers();
-    size_t digitsCount = gcdDigits.size();
-    if (digitsCount == 1) {
-        if (gcdDigits[0] == 1) {
-            return;
-        }
+    const NaturalNumber one(1);
+    if (gcd.cmp(&one) == 0) {
+        return;
     }
 
     // Сокращаем на НОД. Если мы сократили на НОД, то
     // это максимально возможно ужатая версия чисел. Дальше никак.
-    IntegerNumber reducedNumerator = this->numerator->quotient(IntegerNumber(gcd.getNumbers(), false));
-    NaturalNumber denominator = *this->denominator;
-    NaturalNumber reducedDenominator = denominator.quotient(gcd);
+    // Деление точное, поэтому делятся модули, а знак числителя сохраняется
+    IntegerNumber reducedNumerator(this->numerator.magnitude().quotient(gcd), this->numerator.getSign() == 1);
+    NaturalNumber reducedDenominator = this->denominator.quotient(gcd);
 
-    // Удаляем указатели на старые числа, тупо ставим новые.
-    delete this->numerator;
-    delete this->denominator;
-
-    this->numerator = new IntegerNumber(reducedNumerator);
-    this->denominator = new NaturalNumber(reducedDenominator);
+    // Ставим сокращённые числа на место старых.
+    this->numerator = std::move(reducedNumerator);
+    this->denominator = std::move(reducedDenominator);
 }
 
 // Q-2: Проверка сокращенного дробного на целое,
@@ -79,14 +111,9 @@ bool RationalNumber::isInteger() const {
     // (Потому что любое целое - это дробь со знаменателем 1: 56 = 56/1)
 
     this->reduce();
-    const std::vector<uint8_t> &denomDigits = this->denominator->getNumbers();
+    const NaturalNumber one(1);
 
-    if (denomDigits.size() == 1) {
-        if (denomDigits[0] == 1) {
-            return true;
-        }
-    }
-    return false;
+    return this->denominator.cmp(&one) == 0;
 }
 
 // Q-3: Преобразование целого в дробное.
@@ -108,11 +135,16 @@ IntegerNumber RationalNumber::toInteger(const RationalNumber &other) const {
 
     // Раз оно представимо как целое, то знаменатель = 1,
     // про него забываем, нас волнует только числитель.
-    return IntegerNumber(*this->numerator);
+    return IntegerNumber(this->numerator);
 }
 
 //Q5: Сложение дробей
 RationalNumber RationalNumber::add(const RationalNumber &other) const {
+    IntegerNumber smallNumerator(0LL);
+    Limb smallDenominator;
+    if (addSmall(*this, other, false, smallNumerator, smallDenominator))
+        return RationalNumber(smallNumerator, NaturalNumber(smallDenominator));
+
     NaturalNumber numeratorThis = this->getIntegerNumerator().abs();
     const NaturalNumber denominatorThis = this->getNaturalDenominator();
 
@@ -124,20 +156,22 @@ RationalNumber RationalNumber::add(const RationalNumber &other) const {
     const NaturalNumber factorThis = commonDenominator.quotient(denominatorThis);
     const NaturalNumber factorOther = commonDenominator.quotient(denominatorOther);
 
-    numeratorThis = numeratorThis.multiply(factorThis);
-    numeratorOther = numeratorOther.multiply(factorOther);
+    numeratorThis *= factorThis;
+    numeratorOther *= factorOther;
 
-    const IntegerNumber sumOfNumerators = IntegerNumber(
-            numeratorThis.getNumbers(), this->getIntegerNumerator().isNegative())
-            .add(
-                    IntegerNumber(numeratorOther.getNumbers(), other.getIntegerNumerator().isNegative())
-            );
+    IntegerNumber sumOfNumerators(numeratorThis, this->getIntegerNumerator().isNegative());
+    sumOfNumerators += IntegerNumber(numeratorOther, other.getIntegerNumerator().isNegative());
 
     return RationalNumber(sumOfNumerators, commonDenominator);
 }
 
 //Q6: Вычитание дробей
 RationalNumber RationalNumber::subtract(const RationalNumber &other) const {
+    IntegerNumber smallNumerator(0LL);
+    Limb smallDenominator;
+    if (addSmall(*this, other, true, smallNumerator, smallDenominator))
+        return RationalNumber(smallNumerator, NaturalNumber(smallDenominator));
+
     NaturalNumber numeratorThis = this->getIntegerNumerator().abs();
     const NaturalNumber denominatorThis = this->getNaturalDenominator();
     NaturalNumber numeratorOther = other.getIntegerNumerator().abs();
@@ -148,14 +182,11 @@ RationalNumber RationalNumber::subtract(const RationalNumber &other) const {
     const NaturalNumber factorThis = commonDenominator.quotient(denominatorThis);
     const NaturalNumber factorOther = commonDenominator.quotient(denominatorOther);
 
-    numeratorThis = numeratorThis.multiply(factorThis);
-    numeratorOther = numeratorOther.multiply(factorOther);
+    numeratorThis *= factorThis;
+    numeratorOther *= factorOther;
 
-    const IntegerNumber diffOfNumerator = IntegerNumber(
-            numeratorThis.getNumbers(), this->getIntegerNumerator().isNegative())
-            .subtract(
-                    IntegerNumber(numeratorOther.getNumbers(), other.getIntegerNumerator().isNegative())
-            );
+    IntegerNumber diffOfNumerator(numeratorThis, this->getIntegerNumerator().isNegative());
+    diffOfNumerator -= IntegerNumber(numeratorOther, other.getIntegerNumerator().isNegative());
 
     return RationalNumber(diffOfNumerator, commonDenominator);
 }
@@ -163,8 +194,12 @@ RationalNumber RationalNumber::subtract(const RationalNumber &other) const {
 //Q-7 Умножение рациональных чисел
 RationalNumber RationalNumber::multiply(const RationalNumber& other) const {
     //Пользуемся умножением натуральных и целых чисел
-    IntegerNumber intres(this->numerator->multiply(other.getIntegerNumerator()));
-    NaturalNumber natres(this->denominator->multiply(other.getNaturalDenominator()));
+    IntegerNumber intres(this->numerator.multiply(other.getIntegerNumerator()));
+    Limb thisDenominator, otherDenominator;
+    if (this->denominator.toLimb(thisDenominator) && other.getNaturalDenominator().toLimb(otherDenominator)) {
+        return RationalNumber(intres, NaturalNumber::fromDoubleLimb(static_cast<DoubleLimb>(thisDenominator) * otherDenominator));
+    }
+    NaturalNumber natres(this->denominator.multiply(other.getNaturalDenominator()));
     return RationalNumber(intres, natres);;
 }
 
@@ -178,10 +213,28 @@ RationalNumber RationalNumber::division(const RationalNumber& other) const {
     //Получаем знак результата
     bool ressign = other.getIntegerNumerator().isNegative();
     //Создаём удобные для дальнейших вычислений объекты
-    IntegerNumber firstmul(other.getNaturalDenominator().getNumbers(), ressign);
-    NaturalNumber secondmul(other.getIntegerNumerator().getNumbers());
+    IntegerNumber firstmul(other.getNaturalDenominator(), ressign);
+    const NaturalNumber &secondmul = other.getIntegerNumerator().magnitude();
     //Так как деление это умножение на обратную дробь, применяем методы умножения
-    IntegerNumber intres(this->numerator->multiply(firstmul));
-    NaturalNumber natres(this->denominator->multiply(secondmul));
+    IntegerNumber intres(this->numerator.multiply(firstmul));
+    NaturalNumber natres(this->denominator.multiply(secondmul));
     return RationalNumber(intres, natres);;
 }
+
+// Квадратный корень существует, только если после сокращения числитель и знаменатель - точные квадраты
+RationalNumber RationalNumber::sqrt() const {
+    if (this->numerator.isNegative()) {
+        throw UniversalStringException("RationalNumber::sqrt: the square root of a negative number is not rational");
+    }
+    this->reduce();
+
+    const NaturalNumber &numeratorAbs = this->numerator.magnitude();
+    const NaturalNumber numeratorRoot = numeratorAbs.isqrt();
+    const NaturalNumber denominatorRoot = this->denominator.isqrt();
+    const NaturalNumber numeratorSquare = numeratorRoot.square();
+    const NaturalNumber denominatorSquare = denominatorRoot.square();
+    if (numeratorSquare.cmp(&numeratorAbs) != 0 || denominatorSquare.cmp(&this->denominator) != 0) {
+        throw UniversalStringException("RationalNumber::sqrt: the square root of " + this->toString() + " is not rational");
+    }
+    return RationalNumber(IntegerNumber(numeratorRoot, false), denominatorRoot);
+}
@@ -10,45 +10,30 @@
 
 class RationalNumber {
 public:
-    RationalNumber(const IntegerNumber& numeratorA, const NaturalNumber& denominatorA){
-        numerator = new IntegerNumber(numeratorA);
-        denominator = new NaturalNumber(denominatorA);
-    }
+    RationalNumber(const IntegerNumber& numeratorA, const NaturalNumber& denominatorA)
+            : numerator(numeratorA), denominator(denominatorA) {}
     RationalNumber(long long numeratorA, long long denominatorA); //решение для облегченного тестирования, потом будет выпелено
     RationalNumber(const std::string& numeratorA, const std::string& denominatorA);
     RationalNumber(const std::string& s); //основной конструктор
 
-    RationalNumber(const RationalNumber& other): numerator(new IntegerNumber(*other.numerator)), denominator(new NaturalNumber(*other.denominator)){}
-    RationalNumber(RationalNumber&& other) noexcept: numerator(other.numerator), denominator(other.denominator){
-        other.denominator = nullptr;
-        other.numerator = nullptr;
+    // Числитель и знаменатель хранятся в самом объекте, поэтому вектор дробей - сплошной массив без указателей.
+    // Копия делит буферы слов (см. LimbStorage), перемещённая дробь становится 0/1
+    RationalNumber(const RationalNumber& other) = default;
+    RationalNumber(RationalNumber&& other) noexcept
+            : numerator(std::move(other.numerator)), denominator(std::move(other.denominator)) {
+        other.denominator = NaturalNumber(1);
     }
 
-    RationalNumber& operator=(const RationalNumber& other){
-        if (this != &other){
-            delete this->denominator;
-            delete this->numerator;
-            this->numerator = new IntegerNumber(*other.numerator);
-            this->denominator = new NaturalNumber(*other.denominator);
-        }
-        return *this;
-    }
-
-    RationalNumber& operator=(RationalNumber&& other) noexcept{
+    RationalNumber& operator=(const RationalNumber& other) = default;
+    RationalNumber& operator=(RationalNumber&& other) noexcept {
         if (this != &other) {
-            this->numerator = other.numerator;
-            this->denominator = other.denominator;
-            other.denominator = nullptr;
-            other.numerator = nullptr;
+            this->numerator = std::move(other.numerator);
+            this->denominator = std::move(other.denominator);
+            other.denominator = NaturalNumber(1);
         }
         return *this;
     }
 
-    ~RationalNumber(){
-        delete numerator;
-        delete denominator;
-    }
-
     static RationalNumber fromInteger(const IntegerNumber& intNum);
     std::string toString() const;
     const IntegerNumber& getIntegerNumerator() const noexcept;
@@ -60,10 +45,12 @@ public:
     RationalNumber subtract(const RationalNumber& other) const;
     RationalNumber multiply(const RationalNumber& other) const;
     RationalNumber division(const RationalNumber& other) const;
+    RationalNumber sqrt() const; //точный корень, если числитель и знаменатель сокращённой дроби - квадраты
 
 private:
-    mutable IntegerNumber* numerator; //числитель
-    mutable NaturalNumber* denominator;
+    // Сокращение в reduce меняет представление, но не значение, поэтому доступно и из const-методов
+    mutable IntegerNumber numerator; //числитель
+    mutable NaturalNumber denominator;
 };
 
 